@@ -146,6 +146,14 @@ typedef struct {
     qboolean mvd;
 } demoInfo_t;
 
+// view of a single client, as recorded in a multi-view demo
+typedef struct {
+    qboolean    valid;              // client was in game in the last parsed frame
+    PlayerState playerState;
+    int         areaBytes;
+    byte        areaBits[MAX_MAP_AREA_BYTES];
+} demoView_t;
+
 typedef enum {
     ACT_MINIMIZED,
     ACT_RESTORED,
@@ -239,6 +247,8 @@ struct ClientStatic {
         qhandle_t   recording;
         uint64_t    time_start;
         uint64_t    time_frames;
+        uint64_t    time_entity_parsing;    // nanoseconds spent parsing packet entities during a timedemo
+        uint64_t    time_entity_states;     // number of entity states parsed during a timedemo
         int         last_server_frame;  // number of server frame the last ServerCommand::Frame was written
         int         frames_written;     // number of frames written to demo file
         int         frames_dropped;     // number of ServerCommand::Frames that didn't fit
@@ -250,10 +260,17 @@ struct ClientStatic {
         int         file_percent;
         SizeBuffer   buffer;
         list_t      snapshots;
+        demoView_t  *views;             // [MAX_CLIENTS] views of a multi-view demo, NULL if it has none
+        int         views_frame;        // number of server frame the views belong to
         qboolean    paused;
         qboolean    seeking;
         qboolean    eof;
+        qboolean    indexing;           // demoindex: parse the whole demo as fast as possible, and write its index
+        qboolean    index_loaded;       // snapshots were loaded from the demo index
+        qboolean    index_written;
+        qboolean    analyzing;          // demoanalyze: parse without refresh and sound, and run the analysis hooks
         char		file_name[MAX_OSPATH];
+        char        index_name[MAX_OSPATH];
     } demo;
 
 };
@@ -512,6 +529,8 @@ void CL_CheckPredictionError(void);
 //
 void CL_InitDemos(void);
 void CL_CleanupDemos(void);
+void CL_ParseDemoViews(void);
+void CL_SetDemoView(void);
 void CL_DemoFrame(int msec);
 qboolean CL_WriteDemoMessage(SizeBuffer *buf);
 void CL_EmitDemoFrame(void);
@@ -520,6 +539,17 @@ void CL_FirstDemoFrame(void);
 void CL_Stop_f(void);
 demoInfo_t *CL_GetDemoInfo(const char *path, demoInfo_t *info);
 
+// called for each frame parsed by demoanalyze, any of the callbacks may be NULL
+typedef struct {
+    void    (*frame)(const ServerFrame *frame, void *arg);
+    void    (*entity)(const ServerFrame *frame, const EntityState *state, void *arg);
+    void    *arg;
+} demoAnalysisHook_t;
+
+qboolean CL_AddDemoAnalysisHook(const demoAnalysisHook_t *hook);
+void CL_RemoveDemoAnalysisHook(const demoAnalysisHook_t *hook);
+void CL_DemoAnalysisFrame(void);
+
 //
 // console.c
 //
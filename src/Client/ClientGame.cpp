@@ -111,6 +111,48 @@ mmodel_t *_wrp_BSP_InlineModel(const char *name) {
     
 	return BSP_InlineModel(cl.bsp, name);
 }
+qboolean _wrp_CM_BoxInPVS(const vec3_t &viewOrigin, const vec3_t &mins, const vec3_t &maxs) {
+	static byte mask[VIS_MAX_BYTES];
+	static bsp_t *maskBSP = nullptr;
+	static int32_t maskCluster = -1;
+	mleaf_t *leafs[64];
+
+	// Without a map, or vis data, everything is potentially visible.
+	if (!cl.bsp || !cl.cm.cache || !cl.bsp->vis) {
+		return true;
+	}
+
+	// Only decompress the view cluster's PVS when the view moved into another cluster.
+	const mleaf_t *viewLeaf = BSP_PointLeaf(cl.bsp->nodes, viewOrigin);
+	if (viewLeaf->cluster == -1) {
+		return true;
+	}
+	if (maskBSP != cl.bsp || maskCluster != viewLeaf->cluster) {
+		BSP_ClusterVis(cl.bsp, mask, viewLeaf->cluster, DVIS_PVS);
+		maskBSP = cl.bsp;
+		maskCluster = viewLeaf->cluster;
+	}
+
+	// Touches too many leafs to bother, assume it is visible.
+	const int32_t numberOfLeafs = CM_BoxLeafs(&cl.cm, mins, maxs, leafs, (int32_t)Q_COUNTOF(leafs), nullptr);
+	if (numberOfLeafs >= (int32_t)Q_COUNTOF(leafs)) {
+		return true;
+	}
+
+	for (int32_t i = 0; i < numberOfLeafs; i++) {
+		const mleaf_t *leaf = leafs[i];
+		if (leaf->cluster == -1 || !Q_IsBitSet(mask, leaf->cluster)) {
+			continue;
+		}
+		// A closed door blocks it.
+		if (cl.frame.areaBytes && !Q_IsBitSet(cl.frame.areaBits, leaf->area)) {
+			continue;
+		}
+		return true;
+	}
+
+	return false;
+}
 void _wrp_CL_LinkEntity(PODEntity *podEntity) {
     CL_LinkEntity(podEntity);
 }
@@ -518,6 +560,7 @@ void CL_InitGameProgs(void)
     importAPI.CM_HeadnodeForOctagon= CM_HeadnodeForOctagon;
     importAPI.BSP_InlineModel = _wrp_BSP_InlineModel;
 	importAPI.CM_InlineModel = _wrp_CM_InlineModel;
+    importAPI.CM_BoxInPVS = _wrp_CM_BoxInPVS;
     importAPI.CM_PointContents = CM_PointContents;
     importAPI.CM_TransformedPointContents = CM_TransformedPointContents;
     importAPI.CM_BoxTrace = CM_BoxTrace;
@@ -578,6 +621,7 @@ void CL_InitGameProgs(void)
 	importAPI.ES_ComputeLocalPoseTransforms = ES_ComputeLocalPoseTransforms;
 	importAPI.ES_ComputeWorldPoseTransforms = ES_ComputeWorldPoseTransforms;
 	importAPI.ES_LerpSkeletonPoses = ES_LerpSkeletonPoses;
+	importAPI.ES_LerpSkeletonPosesForBones = ES_LerpSkeletonPosesForBones;
 	importAPI.ES_RecursiveBlendFromBone = ES_RecursiveBlendFromBone;
 	importAPI.ES_CreateFromModel = ES_CreateFromModel;
 
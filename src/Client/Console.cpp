@@ -78,6 +78,24 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 console_t    con;
 
+// Cached layout of a scrollback line: the runs of visible glyphs, so that
+// drawing skips blank lines and spaces. Only rebuilt when the line changed.
+#define CON_MAXRUNS     (CON_LINEWIDTH / 2)
+
+typedef struct {
+    byte    start;          // offset of the first glyph, past the color byte
+    byte    length;
+} conGlyphRun_t;
+
+typedef struct {
+    qboolean        dirty;
+    int             width;  // x past the last glyph, as returned by R_DrawString
+    int             numRuns;
+    conGlyphRun_t   runs[CON_MAXRUNS];
+} conLineLayout_t;
+
+static conLineLayout_t  con_layouts[CON_TOTALLINES];
+
 static cvar_t   *con_notifytime;
 static cvar_t   *con_notifylines;
 static cvar_t   *con_clock;
@@ -92,6 +110,22 @@ static cvar_t   *con_history;
 
 // ============================================================================
 
+/*
+================
+Con_InvalidateLayouts
+
+Forces the layout of every line to be rebuilt before it is drawn next.
+================
+*/
+static void Con_InvalidateLayouts(void)
+{
+    int     i;
+
+    for (i = 0; i < CON_TOTALLINES; i++) {
+        con_layouts[i].dirty = true;
+    }
+}
+
 /*
 ================
 Con_SkipNotify
@@ -220,6 +254,7 @@ static void Con_Clear_f(void)
 {
     memset(con.text, 0, sizeof(con.text));
     con.display = con.current;
+    Con_InvalidateLayouts();
 }
 
 static void Con_Dump_c(genctx_t *ctx, int argnum)
@@ -389,6 +424,9 @@ void Con_CheckResize(void)
     con.prompt.inputLine.visibleChars = con.linewidth;
     con.prompt.widthInChars = con.linewidth - 1; // account for color byte
     con.chatPrompt.inputLine.visibleChars = con.linewidth;
+
+    // glyphs past the new width are no longer drawn
+    Con_InvalidateLayouts();
 }
 
 /*
@@ -512,6 +550,7 @@ static void Con_CarriageRet(void)
 
     p = con.text[con.current & CON_TOTALLINES_MASK];
     memset(p, 0, sizeof(con.text[0]));
+    con_layouts[con.current & CON_TOTALLINES_MASK].dirty = true;
 
     // add color from last line
     con.x = 0;
@@ -603,6 +642,7 @@ void Con_Print(const char *txt)
             }
             p = con.text[con.current & CON_TOTALLINES_MASK];
             p[con.x++] = *txt;
+            con_layouts[con.current & CON_TOTALLINES_MASK].dirty = true;
             break;
         }
 
@@ -672,9 +712,56 @@ DRAWING
 ==============================================================================
 */
 
+/*
+================
+Con_GetLineLayout
+
+Returns the layout of the line, rebuilding it if the line changed since.
+================
+*/
+static const conLineLayout_t *Con_GetLineLayout(int line)
+{
+    conLineLayout_t *layout = &con_layouts[line & CON_TOTALLINES_MASK];
+    const char *p = con.text[line & CON_TOTALLINES_MASK] + 1;   // skip color byte
+    int i, start, maxChars;
+
+    if (!layout->dirty) {
+        return layout;
+    }
+
+    maxChars = con.linewidth - 1;
+    layout->numRuns = 0;
+
+    i = 0;
+    while (i < maxChars && p[i]) {
+        // spaces draw nothing
+        if ((p[i] & 127) == 32) {
+            i++;
+            continue;
+        }
+
+        start = i;
+        while (i < maxChars && p[i] && (p[i] & 127) != 32) {
+            i++;
+        }
+
+        layout->runs[layout->numRuns].start = start;
+        layout->runs[layout->numRuns].length = i - start;
+        layout->numRuns++;
+    }
+
+    layout->width = CHAR_WIDTH + i * CHAR_WIDTH;
+    layout->dirty = false;
+
+    return layout;
+}
+
 static int Con_DrawLine(int v, int line, float alpha)
 {
     char *p = con.text[line & CON_TOTALLINES_MASK];
+    const conLineLayout_t *layout = Con_GetLineLayout(line);
+    const conGlyphRun_t *run;
+    int i;
     color_index_t c = (color_index_t)(*p);   // CPP: WARNING: CAST: char to color_index_t
     color_t color;
     int flags = 0;
@@ -698,8 +785,12 @@ static int Con_DrawLine(int v, int line, float alpha)
         break;
     }
 
-    return R_DrawString(CHAR_WIDTH, v, flags, con.linewidth - 1, p + 1,
-                        con.charsetImage);
+    for (i = 0, run = layout->runs; i < layout->numRuns; i++, run++) {
+        R_DrawString(CHAR_WIDTH + run->start * CHAR_WIDTH, v, flags, run->length,
+                     p + 1 + run->start, con.charsetImage);
+    }
+
+    return layout->width;
 }
 
 #define CON_PRESTEP     (CHAR_HEIGHT * 3 + CHAR_HEIGHT / 4)
@@ -24,11 +24,22 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include "Client/GameModule.h"
 #include "../Server/Server.h"
 
+#ifndef _WIN32
+#include <errno.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define USE_DEMO_WORKERS    1
+#else
+#define USE_DEMO_WORKERS    0
+#endif
+
 static byte     demo_buffer[MAX_PACKETLEN];
 
 static cvar_t   *cl_demosnaps;
 static cvar_t   *cl_demomsglen;
 static cvar_t   *cl_demowait;
+static cvar_t   *cl_demoindex;
+static cvar_t   *cl_demopov;
 cvar_t   *cl_renderdemo;
 cvar_t   *cl_renderdemo_fps;
 
@@ -643,11 +654,19 @@ static void update_status(void)
     }
 }
 
+static void write_demo_index(void);
+
 static int parse_next_message(int wait)
 {
     int ret;
 
     ret = read_next_message(cls.demo.playback);
+
+    // the snapshots now cover the whole demo, save them for the next playback
+    if (ret == 0) {
+        write_demo_index();
+    }
+
     if (ret < 0 || (ret == 0 && wait == 0)) {
         finish_demo(ret);
         return -1;
@@ -715,8 +734,10 @@ static void CL_PlayDemo_f(void)
     CL_Disconnect(ErrorType::Reconnect);
 
     cls.demo.playback = f;
+    cls.demo.indexing = !strcmp(Cmd_Argv(0), "demoindex");
 
 	Q_strlcpy(cls.demo.file_name, Cmd_Argv(1), sizeof(cls.demo.file_name));
+    Q_concat(cls.demo.index_name, sizeof(cls.demo.index_name), name, ".idx", NULL);
 
     cls.connectionState = ClientConnectionState::Connected;
     Q_strlcpy(cls.servername, COM_SkipPath(name), sizeof(cls.servername));
@@ -855,6 +876,168 @@ static demosnap_t *find_snapshot(int frameNumber)
     return prev;
 }
 
+/*
+====================
+Demo index
+
+An index file stores the snapshots of a demo that was played through to the end,
+so later playbacks can seek anywhere without first parsing everything up to there.
+
+Layout (little endian):
+    header:     magic, version, file offset and size of the demo data it was built from,
+                number of snapshots
+    snapshots:  frame number, file position, message length, message data
+====================
+*/
+
+#define DEMO_INDEX_MAGIC    0x58444944  // "DIDX"
+#define DEMO_INDEX_VERSION  1
+
+static qboolean write_index_uint32(qhandle_t f, uint32_t value)
+{
+    value = LittleLong(value);
+    return FS_Write(&value, 4, f) == 4;
+}
+
+static qboolean read_index_uint32(qhandle_t f, uint32_t *value)
+{
+    if (FS_Read(value, 4, f) != 4) {
+        return false;
+    }
+    *value = LittleLong(*value);
+    return true;
+}
+
+/*
+====================
+write_demo_index
+
+Writes all snapshots out to the demo index, unless it was loaded from one.
+====================
+*/
+static void write_demo_index(void)
+{
+    demosnap_t *snap;
+    qhandle_t f;
+    uint32_t count;
+    qboolean ok;
+
+    if (cls.demo.index_loaded || cls.demo.index_written) {
+        return;
+    }
+    if (!cls.demo.indexing && !cl_demoindex->integer) {
+        return;
+    }
+    if (!cls.demo.file_size || !cls.demo.index_name[0] || LIST_EMPTY(&cls.demo.snapshots)) {
+        return;
+    }
+
+    // only demos that can be seeked in are indexed
+    if (FS_Seek(cls.demo.playback, FS_Tell(cls.demo.playback)) < 0) {
+        return;
+    }
+
+    FS_FOpenFile(cls.demo.index_name, &f, FS_MODE_WRITE);
+    if (!f) {
+        Com_EPrintf("Couldn't open %s for writing\n", cls.demo.index_name);
+        return;
+    }
+
+    count = 0;
+    LIST_FOR_EACH(demosnap_t, snap, &cls.demo.snapshots, entry) {
+        count++;
+    }
+
+    ok = write_index_uint32(f, DEMO_INDEX_MAGIC) &&
+         write_index_uint32(f, DEMO_INDEX_VERSION) &&
+         write_index_uint32(f, cls.demo.file_offset) &&
+         write_index_uint32(f, cls.demo.file_size) &&
+         write_index_uint32(f, count);
+
+    LIST_FOR_EACH(demosnap_t, snap, &cls.demo.snapshots, entry) {
+        if (!ok) {
+            break;
+        }
+        ok = write_index_uint32(f, snap->frameNumber) &&
+             write_index_uint32(f, snap->filepos) &&
+             write_index_uint32(f, snap->msglen) &&
+             FS_Write(snap->data, snap->msglen, f) == snap->msglen;
+    }
+
+    FS_FCloseFile(f);
+
+    if (!ok) {
+        Com_EPrintf("Couldn't write %s\n", cls.demo.index_name);
+        return;
+    }
+
+    cls.demo.index_written = true;
+    Com_Printf("Wrote %u snapshots to %s.\n", count, cls.demo.index_name);
+}
+
+/*
+====================
+load_demo_index
+
+Loads the snapshots from the demo index, if there is one matching the demo.
+====================
+*/
+static void load_demo_index(void)
+{
+    demosnap_t *snap;
+    qhandle_t f;
+    uint32_t magic, version, offset, size, count, frameNumber, filepos, msglen, i;
+
+    if (!cl_demoindex->integer || cls.demo.indexing || !cls.demo.file_size || !cls.demo.index_name[0]) {
+        return;
+    }
+
+    FS_FOpenFile(cls.demo.index_name, &f, FS_MODE_READ);
+    if (!f) {
+        return;
+    }
+
+    // ignore indexes of other versions, or of a demo that has since changed
+    if (!read_index_uint32(f, &magic) || magic != DEMO_INDEX_MAGIC ||
+        !read_index_uint32(f, &version) || version != DEMO_INDEX_VERSION ||
+        !read_index_uint32(f, &offset) || offset != cls.demo.file_offset ||
+        !read_index_uint32(f, &size) || size != cls.demo.file_size ||
+        !read_index_uint32(f, &count)) {
+        Com_DPrintf("Ignoring outdated demo index %s\n", cls.demo.index_name);
+        FS_FCloseFile(f);
+        return;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (!read_index_uint32(f, &frameNumber) || !read_index_uint32(f, &filepos) ||
+            !read_index_uint32(f, &msglen) || msglen > MAX_MSGLEN) {
+            break;
+        }
+
+        // CPP: Cast void* to demosnap_t *
+        snap = (demosnap_t*)Z_Malloc(sizeof(*snap) + msglen - 1);
+        snap->frameNumber = frameNumber;
+        snap->filepos = filepos;
+        snap->msglen = msglen;
+        if (FS_Read(snap->data, msglen, f) != msglen) {
+            Z_Free(snap);
+            break;
+        }
+        List_Append(&cls.demo.snapshots, &snap->entry);
+
+        cls.demo.last_snapshot = frameNumber;
+    }
+
+    FS_FCloseFile(f);
+
+    if (i != count) {
+        Com_EPrintf("Couldn't read %s\n", cls.demo.index_name);
+    }
+
+    cls.demo.index_loaded = true;
+    Com_DPrintf("Loaded %u snapshots from %s\n", i, cls.demo.index_name);
+}
+
 /*
 ====================
 CL_FirstDemoFrame
@@ -883,10 +1066,15 @@ void CL_FirstDemoFrame(void)
     if (com_timedemo->integer) {
         cls.demo.time_frames = 0;
         cls.demo.time_start = Sys_Milliseconds();
+        cls.demo.time_entity_parsing = 0;
+        cls.demo.time_entity_states = 0;
     }
 
     // force initial snapshot
     cls.demo.last_snapshot = INT_MIN;
+
+    // load the snapshots of the whole demo if it has been indexed before
+    load_demo_index();
 }
 
 static void CL_Seek_f(void)
@@ -951,6 +1139,11 @@ static void CL_Seek_f(void)
     if (frames < 0 || cls.demo.last_snapshot > cls.demo.frames_read) {
         snap = find_snapshot(dest);
 
+        // when seeking forward, only jump if it's past our current frame
+        if (snap && frames > 0 && snap->frameNumber <= cls.demo.frames_read) {
+            snap = NULL;
+        }
+
         if (snap) {
             Com_DPrintf("found snap at %d\n", snap->frameNumber);
             ret = FS_Seek(cls.demo.playback, snap->filepos);
@@ -1041,6 +1234,558 @@ done:
     cls.demo.seeking = false;
 }
 
+/*
+====================
+CL_ParseDemoViews
+
+Multi-view demos precede each frame with the views of all clients in game.
+Each one is delta compressed against the same client's view in the previous
+frame, unless it is flagged EPS_NODELTA.
+====================
+*/
+void CL_ParseDemoViews(void)
+{
+    demoView_t *view;
+    int i, count, number, flags, length;
+
+    if (!cls.demo.views) {
+        cls.demo.views = (demoView_t *)Z_Mallocz(sizeof(*cls.demo.views) * MAX_CLIENTS);
+    }
+
+    cls.demo.views_frame = MSG_ReadInt32() & FRAMENUM_MASK;
+    count = MSG_ReadInt16();
+
+    // clients that aren't in this frame have left the game
+    for (i = 0; i < MAX_CLIENTS; i++) {
+        cls.demo.views[i].valid = false;
+    }
+
+    for (i = 0; i < count; i++) {
+        number = MSG_ReadUint8();
+        flags = MSG_ReadUint8();
+        if (number < 0 || number >= MAX_CLIENTS || flags < 0) {
+            Com_Error(ErrorType::Drop, "%s: read past end of message", __func__);
+        }
+
+        view = &cls.demo.views[number];
+
+        length = MSG_ReadUint8();
+        if (length < 0 || msg_read.readCount + length > msg_read.currentSize) {
+            Com_Error(ErrorType::Drop, "%s: read past end of message", __func__);
+        }
+        if (length > sizeof(view->areaBits)) {
+            Com_Error(ErrorType::Drop, "%s: invalid areaBits length", __func__);
+        }
+        memcpy(view->areaBits, msg_read.data + msg_read.readCount, length);
+        msg_read.readCount += length;
+        view->areaBytes = length;
+
+        MSG_ParseDeltaPlayerstate((flags & EPS_NODELTA) ? NULL : &view->playerState,
+                                  &view->playerState, flags & EPS_MASK);
+        view->valid = true;
+    }
+}
+
+/*
+====================
+CL_SetDemoView
+
+Shows the frame that was just parsed from the view of the client picked by
+cl_demopov, if the demo has it. Otherwise the recorded view is kept.
+====================
+*/
+void CL_SetDemoView(void)
+{
+    demoView_t *view;
+    int pov;
+
+    if (!cls.demo.playback || !cls.demo.views || cls.demo.views_frame != cl.frame.number)
+        return;
+
+    pov = cl_demopov->integer;
+    if (pov < 0 || pov >= MAX_CLIENTS || !cls.demo.views[pov].valid)
+        return;
+
+    view = &cls.demo.views[pov];
+    cl.frame.playerState = view->playerState;
+    cl.frame.clientNumber = pov;
+    cl.frame.areaBytes = view->areaBytes;
+    memcpy(cl.frame.areaBits, view->areaBits, view->areaBytes);
+
+    // don't lerp from the view of another client
+    if (cl.oldframe.clientNumber != pov) {
+        cl.oldframe.playerState = cl.frame.playerState;
+    }
+}
+
+/*
+====================
+CL_DemoPOV_f
+
+demopov [clientnum]
+
+Switches to the view of the given client, or of the next client in game.
+-1 goes back to the recorded view.
+====================
+*/
+static void CL_DemoPOV_f(void)
+{
+    int i, pov;
+
+    if (!cls.demo.playback) {
+        Com_Printf("Not playing a demo.\n");
+        return;
+    }
+
+    if (!cls.demo.views) {
+        Com_Printf("This demo only has the view of a single client.\n");
+        return;
+    }
+
+    if (Cmd_Argc() > 1) {
+        pov = atoi(Cmd_Argv(1));
+    } else {
+        pov = cl.frame.clientNumber;
+        for (i = 0; i < MAX_CLIENTS; i++) {
+            pov = (pov + 1) % MAX_CLIENTS;
+            if (cls.demo.views[pov].valid)
+                break;
+        }
+    }
+
+    Cvar_SetInteger(cl_demopov, pov, FROM_CONSOLE);
+
+    if (pov < 0) {
+        Com_Printf("Showing the recorded view.\n");
+    } else if (pov < MAX_CLIENTS && cls.demo.views[pov].valid) {
+        Com_Printf("Showing the view of %s.\n", cl.clientInfo[pov].name);
+    } else {
+        Com_Printf("Client %d is not in game.\n", pov);
+    }
+}
+
+/*
+====================
+Demo analysis
+
+demoanalyze parses demos as fast as they can be read, without loading any
+media and without running effects or sounds, and calls the registered hooks
+for each parsed frame.
+
+The client state is global, so a single process parses one demo at a time.
+To use multiple cores the demo list is split over cl_demoanalyze_workers
+worker processes, forked off the client so they start out with its state.
+Each worker sends the results of its demos back through a pipe. Where fork
+is not available the demos are processed one after another.
+====================
+*/
+
+#define MAX_DEMO_ANALYSIS_HOOKS     8
+#define MAX_DEMO_ANALYSIS_WORKERS   64
+
+static const demoAnalysisHook_t *demo_analysis_hooks[MAX_DEMO_ANALYSIS_HOOKS];
+static int demo_analysis_numhooks;
+
+static cvar_t   *cl_demoanalyze_dump;
+static cvar_t   *cl_demoanalyze_workers;
+
+// results of a single demo, as sent back by a worker
+typedef struct {
+    int         index;          // of the demo in the list
+    int         frames;         // -1 if the demo couldn't be analyzed
+    uint64_t    entities;
+    uint64_t    msec;
+} demoAnalysis_t;
+
+static qhandle_t    demo_analysis_dump;
+static uint64_t     demo_analysis_entities;
+
+qboolean CL_AddDemoAnalysisHook(const demoAnalysisHook_t *hook)
+{
+    int i;
+
+    for (i = 0; i < demo_analysis_numhooks; i++) {
+        if (demo_analysis_hooks[i] == hook) {
+            return true;
+        }
+    }
+
+    if (demo_analysis_numhooks == MAX_DEMO_ANALYSIS_HOOKS) {
+        Com_WPrintf("%s: too many hooks\n", __func__);
+        return false;
+    }
+
+    demo_analysis_hooks[demo_analysis_numhooks++] = hook;
+    return true;
+}
+
+void CL_RemoveDemoAnalysisHook(const demoAnalysisHook_t *hook)
+{
+    int i;
+
+    for (i = 0; i < demo_analysis_numhooks; i++) {
+        if (demo_analysis_hooks[i] == hook) {
+            demo_analysis_hooks[i] = demo_analysis_hooks[--demo_analysis_numhooks];
+            return;
+        }
+    }
+}
+
+/*
+====================
+CL_DemoAnalysisFrame
+
+Called by CL_ParseFrame for each frame parsed by demoanalyze.
+====================
+*/
+void CL_DemoAnalysisFrame(void)
+{
+    const demoAnalysisHook_t *hook;
+    const EntityState *state;
+    int i, j;
+
+    demo_analysis_entities += cl.frame.numEntities;
+
+    for (i = 0; i < demo_analysis_numhooks; i++) {
+        hook = demo_analysis_hooks[i];
+
+        if (hook->frame) {
+            hook->frame(&cl.frame, hook->arg);
+        }
+
+        if (!hook->entity) {
+            continue;
+        }
+
+        for (j = 0; j < cl.frame.numEntities; j++) {
+            state = &cl.entityStates[(cl.frame.firstEntity + j) & PARSE_ENTITIES_MASK];
+            hook->entity(&cl.frame, state, hook->arg);
+        }
+    }
+}
+
+static void dump_analysis_frame(const ServerFrame *frame, void *arg)
+{
+    const PlayerState *ps = &frame->playerState;
+
+    FS_FPrintf(demo_analysis_dump, "frame %d client %d origin %.1f %.1f %.1f velocity %.1f %.1f %.1f entities %d\n",
+               frame->number, frame->clientNumber,
+               ps->pmove.origin.x, ps->pmove.origin.y, ps->pmove.origin.z,
+               ps->pmove.velocity.x, ps->pmove.velocity.y, ps->pmove.velocity.z,
+               frame->numEntities);
+}
+
+static void dump_analysis_entity(const ServerFrame *frame, const EntityState *state, void *arg)
+{
+    FS_FPrintf(demo_analysis_dump, "  entity %d model %d frame %.1f origin %.1f %.1f %.1f\n",
+               state->number, state->modelIndex, state->animationFrame,
+               state->origin.x, state->origin.y, state->origin.z);
+}
+
+// level 1 dumps the player state of each frame, level 2 adds the entities
+static const demoAnalysisHook_t dump_frame_hook = { dump_analysis_frame, NULL, NULL };
+static const demoAnalysisHook_t dump_entity_hook = { NULL, dump_analysis_entity, NULL };
+
+static void open_analysis_dump(const char *name)
+{
+    char buffer[MAX_OSPATH];
+
+    if (cl_demoanalyze_dump->integer <= 0) {
+        return;
+    }
+
+    if (Q_concat(buffer, sizeof(buffer), name, ".txt", NULL) >= sizeof(buffer)) {
+        Com_EPrintf("Oversize filename specified.\n");
+        return;
+    }
+
+    FS_FOpenFile(buffer, &demo_analysis_dump, FS_MODE_WRITE);
+    if (!demo_analysis_dump) {
+        Com_EPrintf("Couldn't open %s for writing\n", buffer);
+        return;
+    }
+
+    CL_AddDemoAnalysisHook(&dump_frame_hook);
+    if (cl_demoanalyze_dump->integer > 1) {
+        CL_AddDemoAnalysisHook(&dump_entity_hook);
+    }
+}
+
+static void close_analysis_dump(void)
+{
+    if (!demo_analysis_dump) {
+        return;
+    }
+
+    CL_RemoveDemoAnalysisHook(&dump_frame_hook);
+    CL_RemoveDemoAnalysisHook(&dump_entity_hook);
+
+    FS_FCloseFile(demo_analysis_dump);
+    demo_analysis_dump = 0;
+}
+
+/*
+====================
+analyze_demo
+
+Parses the whole demo headless. Sets result->frames to -1 if the demo
+couldn't be opened.
+====================
+*/
+static void analyze_demo(const char *arg, demoAnalysis_t *result)
+{
+    char name[MAX_OSPATH];
+    qhandle_t f;
+    int type, ret;
+    uint64_t start;
+
+    result->frames = -1;
+    result->entities = 0;
+    result->msec = 0;
+
+    f = FS_EasyOpenFile(name, sizeof(name), FS_MODE_READ,
+                        "demos/", arg, ".dm2");
+    if (!f) {
+        return;
+    }
+
+    type = read_first_message(f);
+    if (type < 0) {
+        Com_Printf("Couldn't read %s: %s\n", name, Q_ErrorString(type));
+        FS_FCloseFile(f);
+        return;
+    }
+
+    if (type == 1) {
+        Com_Printf("MVD support was not compiled in.\n");
+        FS_FCloseFile(f);
+        return;
+    }
+
+    CL_Disconnect(ErrorType::Reconnect);
+
+    cls.demo.playback = f;
+    cls.demo.analyzing = true;
+
+    // disable effects processing and configstring updates
+    cls.demo.seeking = true;
+
+    Q_strlcpy(cls.demo.file_name, arg, sizeof(cls.demo.file_name));
+
+    cls.connectionState = ClientConnectionState::Connected;
+    Q_strlcpy(cls.servername, COM_SkipPath(name), sizeof(cls.servername));
+    cls.serverAddress.type = NA_LOOPBACK;
+
+    demo_analysis_entities = 0;
+    open_analysis_dump(name);
+
+    start = Sys_Milliseconds();
+
+    // parse the first message just read
+    CL_ParseServerMessage();
+
+    // read and parse messages until `precache' command, which skips loading media
+    ret = 1;
+    while (cls.connectionState == ClientConnectionState::Connected) {
+        Cbuf_Execute(&cl_cmdbuf);
+        if (cls.connectionState != ClientConnectionState::Connected) {
+            break;
+        }
+        ret = read_next_message(f);
+        if (ret <= 0) {
+            break;
+        }
+        CL_ParseServerMessage();
+    }
+
+    // fast forward through the rest of the demo
+    while (ret > 0) {
+        ret = read_next_message(f);
+        if (ret <= 0) {
+            break;
+        }
+        CL_SeekDemoMessage();
+    }
+
+    result->msec = Sys_Milliseconds() - start;
+    result->frames = cls.demo.frames_read;
+    result->entities = demo_analysis_entities;
+
+    if (ret < 0) {
+        Com_EPrintf("Couldn't read %s: %s\n", name, Q_ErrorString(ret));
+    }
+
+    close_analysis_dump();
+
+    CL_Disconnect(ErrorType::Reconnect);
+}
+
+#if USE_DEMO_WORKERS
+/*
+====================
+analyze_demos_forked
+
+Forks a worker process for each share of the demos, worker w analyzes the
+demos w, w + numWorkers, ... and writes their results to its pipe. Shares
+whose worker couldn't be started are analyzed in this process instead.
+====================
+*/
+static void analyze_demos_forked(char **names, int numDemos, int numWorkers, demoAnalysis_t *results)
+{
+    pid_t pids[MAX_DEMO_ANALYSIS_WORKERS];
+    int fds[MAX_DEMO_ANALYSIS_WORKERS];
+    demoAnalysis_t result;
+    int w, i, p[2];
+    ssize_t ret;
+
+    for (w = 0; w < numWorkers; w++) {
+        pids[w] = -1;
+        fds[w] = -1;
+
+        if (pipe(p)) {
+            Com_EPrintf("Couldn't create pipe for demo analysis worker: %s\n", strerror(errno));
+            continue;
+        }
+
+        pids[w] = fork();
+        if (pids[w] < 0) {
+            Com_EPrintf("Couldn't fork demo analysis worker: %s\n", strerror(errno));
+            close(p[0]);
+            close(p[1]);
+            continue;
+        }
+
+        if (pids[w] == 0) {
+            // worker, analyze our share and leave without running any shutdown code
+            close(p[0]);
+            for (i = w; i < numDemos; i += numWorkers) {
+                analyze_demo(names[i], &result);
+                result.index = i;
+                if (write(p[1], &result, sizeof(result)) != sizeof(result)) {
+                    break;
+                }
+            }
+            close(p[1]);
+            _exit(0);
+        }
+
+        close(p[1]);
+        fds[w] = p[0];
+    }
+
+    for (w = 0; w < numWorkers; w++) {
+        if (fds[w] < 0) {
+            for (i = w; i < numDemos; i += numWorkers) {
+                analyze_demo(names[i], &results[i]);
+            }
+            continue;
+        }
+
+        // read results until the worker is done
+        while (1) {
+            ret = read(fds[w], &result, sizeof(result));
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ret != sizeof(result)) {
+                break;
+            }
+            if (result.index >= 0 && result.index < numDemos) {
+                results[result.index] = result;
+            }
+        }
+
+        close(fds[w]);
+        while (waitpid(pids[w], NULL, 0) < 0 && errno == EINTR) {
+        }
+    }
+}
+#endif
+
+/*
+====================
+CL_AnalyzeDemos_f
+====================
+*/
+static void CL_AnalyzeDemos_f(void)
+{
+    int i, numDemos, numWorkers, demos, total_frames;
+    uint64_t start, msec, total_entities;
+    demoAnalysis_t *results;
+    char **names;
+
+    if (Cmd_Argc() < 2) {
+        Com_Printf("Usage: %s <filename> [...]\n", Cmd_Argv(0));
+        return;
+    }
+
+    // if running a local server, kill it
+    SV_Shutdown("Server was killed.\n", ErrorType::Disconnect);
+
+    // the arguments are overwritten by the commands each demo executes
+    numDemos = Cmd_Argc() - 1;
+    names = (char **)Z_Malloc(sizeof(*names) * numDemos);
+    results = (demoAnalysis_t *)Z_Mallocz(sizeof(*results) * numDemos);
+    for (i = 0; i < numDemos; i++) {
+        names[i] = Z_CopyString(Cmd_Argv(i + 1));
+        results[i].index = i;
+        results[i].frames = -1;
+    }
+
+    numWorkers = cl_demoanalyze_workers->integer;
+    if (numWorkers <= 0) {
+        numWorkers = (int)std::thread::hardware_concurrency();
+    }
+    numWorkers = Clampi(numWorkers, 1, min(numDemos, MAX_DEMO_ANALYSIS_WORKERS));
+
+    start = Sys_Milliseconds();
+
+#if USE_DEMO_WORKERS
+    if (numWorkers > 1) {
+        analyze_demos_forked(names, numDemos, numWorkers, results);
+    } else
+#endif
+    {
+        numWorkers = 1;
+        for (i = 0; i < numDemos; i++) {
+            analyze_demo(names[i], &results[i]);
+        }
+    }
+
+    msec = Sys_Milliseconds() - start;
+
+    demos = total_frames = 0;
+    total_entities = 0;
+    for (i = 0; i < numDemos; i++) {
+        if (results[i].frames < 0) {
+            Com_Printf("%s: couldn't be analyzed\n", names[i]);
+            continue;
+        }
+
+        Com_Printf("%s: %d frames, %llu entity states, %.3f seconds: %.1f fps\n",
+                   names[i], results[i].frames, (unsigned long long)results[i].entities,
+                   results[i].msec * 0.001,
+                   results[i].msec ? results[i].frames * 1000.0 / results[i].msec : 0.0);
+
+        demos++;
+        total_frames += results[i].frames;
+        total_entities += results[i].entities;
+    }
+
+    if (demos > 1) {
+        Com_Printf("%d demos in %d %s: %d frames, %llu entity states, %.3f seconds: %.1f fps\n",
+                   demos, numWorkers, numWorkers > 1 ? "workers" : "worker", total_frames,
+                   (unsigned long long)total_entities, msec * 0.001,
+                   msec ? total_frames * 1000.0 / msec : 0.0);
+    }
+
+    for (i = 0; i < numDemos; i++) {
+        Z_Free(names[i]);
+    }
+    Z_Free(names);
+    Z_Free(results);
+}
+
 static void parse_info_string(demoInfo_t *info, int clientNumber, int index, const char *string)
 {
     size_t len;
@@ -1139,6 +1884,11 @@ void CL_CleanupDemos(void)
         CL_Stop_f();
     }
 
+    // demoanalyze was interrupted by an error
+    if (cls.demo.analyzing) {
+        close_analysis_dump();
+    }
+
     if (cls.demo.playback) {
         FS_FCloseFile(cls.demo.playback);
 
@@ -1152,6 +1902,12 @@ void CL_CleanupDemos(void)
                 Com_Printf("%u frames, %3.1f seconds: %f fps\n",
                            cls.demo.time_frames, sec, fps);
             }
+
+            if (cls.demo.time_entity_states) {
+                Com_Printf("%llu entity states parsed in %.3f ms: %.3f usec per entity state\n",
+                           (unsigned long long)cls.demo.time_entity_states, cls.demo.time_entity_parsing * 0.000001,
+                           (double)cls.demo.time_entity_parsing * 0.001 / cls.demo.time_entity_states);
+            }
         }
     }
 
@@ -1165,6 +1921,8 @@ void CL_CleanupDemos(void)
         Com_DPrintf("Freed %" PRIz " bytes of snaps\n", total);
     }
 
+    Z_Free(cls.demo.views);
+
     memset(&cls.demo, 0, sizeof(cls.demo));
 
     List_Init(&cls.demo.snapshots);
@@ -1186,6 +1944,15 @@ void CL_DemoFrame(int msec)
         return;
     }
 
+    // build the demo index as fast as we can
+    if (cls.demo.indexing) {
+        while (cls.demo.playback && cls.connectionState == ClientConnectionState::Active) {
+            if (parse_next_message(0))
+                break;
+        }
+        return;
+    }
+
     if (com_timedemo->integer) {
         parse_next_message(0);
         cl.time = cl.serverTime;
@@ -1212,10 +1979,13 @@ void CL_DemoFrame(int msec)
 
 static const cmdreg_t c_demo[] = {
     { "demo", CL_PlayDemo_f, CL_Demo_c },
+    { "demoindex", CL_PlayDemo_f, CL_Demo_c },
     { "record", CL_Record_f, CL_Demo_c },
     { "stop", CL_Stop_f },
     { "suspend", CL_Suspend_f },
     { "seek", CL_Seek_f },
+    { "demopov", CL_DemoPOV_f },
+    { "demoanalyze", CL_AnalyzeDemos_f, CL_Demo_c },
 
     { NULL }
 };
@@ -1230,6 +2000,10 @@ void CL_InitDemos(void)
     cl_demosnaps = Cvar_Get("cl_demosnaps", "10", 0);
     cl_demomsglen = Cvar_Get("cl_demomsglen", va("%d", MAX_PACKETLEN_WRITABLE_DEFAULT), 0);
     cl_demowait = Cvar_Get("cl_demowait", "0", 0);
+    cl_demoindex = Cvar_Get("cl_demoindex", "1", 0);
+    cl_demopov = Cvar_Get("cl_demopov", "-1", 0);
+    cl_demoanalyze_dump = Cvar_Get("cl_demoanalyze_dump", "0", 0);
+    cl_demoanalyze_workers = Cvar_Get("cl_demoanalyze_workers", "0", 0);
 
 	cl_renderdemo = Cvar_Get("cl_renderdemo", "0", CVAR_ARCHIVE);
 	cl_renderdemo_fps = Cvar_Get("cl_renderdemo_fps", "60", CVAR_ARCHIVE);
@@ -1672,6 +1672,13 @@ static void CL_Precache_f(void)
 
     S_StopAllSounds();
 
+    // Demo analysis doesn't need any media
+    if (cls.demo.analyzing) {
+        CL_LoadState(LOAD_NONE);
+        cls.connectionState = ClientConnectionState::Precached;
+        return;
+    }
+
     // Demos use different precache sequence
     if (cls.demo.playback) {
         CL_RegisterBspModels();
@@ -317,7 +317,18 @@ static void CL_ParseFrame(int extrabits)
 
     SHOWNET(2, "%3" PRIz ":packetentities\n", msg_read.readCount - 1);
 
-    CL_ParsePacketEntities(oldframe, &frame);
+    // Timedemos also benchmark the packet entity parsing.
+    if (com_timedemo->integer && cls.demo.playback) {
+        const auto parseStart = std::chrono::steady_clock::now();
+        const int32_t firstEntityState = cl.numEntityStates;
+
+        CL_ParsePacketEntities(oldframe, &frame);
+
+        cls.demo.time_entity_parsing += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - parseStart).count();
+        cls.demo.time_entity_states += cl.numEntityStates - firstEntityState;
+    } else {
+        CL_ParsePacketEntities(oldframe, &frame);
+    }
 
     // save the frame off in the backup array for later delta comparisons
     cl.frames[currentframe & UPDATE_MASK] = frame;
@@ -351,8 +362,15 @@ static void CL_ParseFrame(int extrabits)
     cl.oldframe = cl.frame;
     cl.frame = frame;
 
+    // multi-view demos can be watched from the view of any client
+    CL_SetDemoView();
+
     cls.demo.frames_read++;
 
+    if (cls.demo.analyzing) {
+        CL_DemoAnalysisFrame();
+    }
+
     if (!cls.demo.seeking) {
         CL_DeltaFrame();
 	}
@@ -892,6 +910,10 @@ badbyte:
             CL_ParseFrame(extrabits);
             continue;
 
+        case ServerCommand::PlayerStates:
+            CL_ParseDemoViews();
+            continue;
+
         case ServerCommand::ZPacket:
             CL_ParseZPacket();
             continue;
@@ -1016,6 +1038,10 @@ void CL_SeekDemoMessage(void)
             CL_ParseFrame(extrabits);
             continue;
 
+        case ServerCommand::PlayerStates:
+            CL_ParseDemoViews();
+            continue;
+
         // N&C: Moved to CGModule.
         //case ServerGameCommand::Inventory:
         //    CL_ParseInventory();
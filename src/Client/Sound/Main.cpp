@@ -71,6 +71,7 @@ cvar_t		*s_voiceinput;
 cvar_t		*s_voiceinput_volume;
 //cvar_t		*s_reverb_set_preset;
 cvar_t      *s_ambient;
+cvar_t      *s_stream_threshold;
 
 
 #ifdef _DEBUG
@@ -127,9 +128,14 @@ static void S_SoundList_f(void)
                 size = sc->size;
             else
 #endif
+            if (sc->streamed)
+                size = sc->datasize;
+            else
                 size = sc->length * sc->width;
             total += size;
-            if (sc->loopstart >= 0)
+            if (sc->streamed)
+                Com_Printf("S");
+            else if (sc->loopstart >= 0)
                 Com_Printf("L");
             else
                 Com_Printf(" ");
@@ -200,6 +206,7 @@ void S_Init(void)
 	s_underwater = Cvar_Get("s_underwater", "1", CVAR_ARCHIVE);
 	s_underwater_gain_hf = Cvar_Get("s_underwater_gain_hf", "0.25", CVAR_ARCHIVE);
     s_ambient = Cvar_Get("s_ambient", "1", 0);
+    s_stream_threshold = Cvar_Get("s_stream_threshold", "5", 0);
 
 	//s_reverb_set_preset = Cvar_Get("s_reverb_set_preset", "7", CVAR_SERVERINFO);
 	//s_reverb_set_preset->changed = reverb_set_preset_changed;
@@ -263,6 +270,8 @@ fail:
 
 static void S_FreeSound(sfx_t *sfx)
 {
+    OGG_CloseSfxStreams(sfx);
+
 #if USE_OPENAL
     if (s_started == SS_OAL)
         AL_DeleteSfx(sfx);
@@ -1016,6 +1025,9 @@ void S_StopAllSounds(void)
 
     // clear all the channels
     memset(channels, 0, sizeof(channels));
+
+    // and release their decoders
+    OGG_CloseSfxStreams(NULL);
 }
 
 // =======================================================================
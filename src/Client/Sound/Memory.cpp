@@ -282,6 +282,102 @@ static qboolean GetWavinfo(void)
     return true;
 }
 
+/*
+===============================================================================
+
+OGG loading
+
+===============================================================================
+*/
+
+/*
+================
+S_CreateStreamedSfx
+
+Keeps the compressed data around, channels decode it while playing
+================
+*/
+static sfxcache_t *S_CreateStreamedSfx(sfx_t *sfx, const byte *data, size_t len)
+{
+    sfxcache_t *sc;
+
+    // CPP: Cast
+    sc = sfx->cache = (sfxcache_t*)S_Malloc(len + sizeof(sfxcache_t) - 1);
+
+    sc->loopstart = -1;
+    sc->width = 2;
+    sc->streamed = true;
+    sc->rate = s_info.rate;
+    sc->numsamples = s_info.samples;
+    sc->datasize = len;
+    memcpy(sc->data, data, len);
+
+#if USE_OPENAL
+    if (s_started == SS_OAL) {
+        sc->length = (int64_t)s_info.samples * 1000 / s_info.rate; // in msec
+        sc->size = len;
+        sc->bufnum = 0;
+    }
+#endif
+
+#if USE_SNDDMA
+    if (s_started == SS_DMA) {
+        sc->length = (int64_t)s_info.samples * dma.speed / s_info.rate;
+    }
+#endif
+
+    if (!sc->length) {
+        Z_Free(sc);
+        sfx->cache = NULL;
+        sfx->error = Q_ERR_TOO_FEW;
+        return NULL;
+    }
+
+    return sc;
+}
+
+/*
+================
+S_LoadOggSound
+================
+*/
+static sfxcache_t *S_LoadOggSound(sfx_t *sfx, const byte *data, size_t len)
+{
+    sfxcache_t *sc = NULL;
+
+    if (!OGG_GetSfxInfo(data, len)) {
+        sfx->error = Q_ERR_INVALID_FORMAT;
+        return NULL;
+    }
+
+    // long sounds are streamed
+    if (s_info.samples > s_stream_threshold->value * s_info.rate) {
+        return S_CreateStreamedSfx(sfx, data, len);
+    }
+
+    // short sounds are decoded up front and take the regular path
+    s_info.data = OGG_DecodeSfx(data, len);
+    if (!s_info.data) {
+        sfx->error = Q_ERR_INVALID_FORMAT;
+        return NULL;
+    }
+
+#if USE_OPENAL
+    if (s_started == SS_OAL)
+        sc = AL_UploadSfx(sfx);
+#endif
+
+#if USE_SNDDMA
+    if (s_started == SS_DMA)
+        sc = ResampleSfx(sfx);
+#endif
+
+    Z_Free(s_info.data);
+    s_info.data = NULL;
+
+    return sc;
+}
+
 /*
 ==============
 S_LoadSound
@@ -321,6 +417,11 @@ sfxcache_t *S_LoadSound(sfx_t *s)
     memset(&s_info, 0, sizeof(s_info));
     s_info.name = name;
 
+    if (OGG_IsSfxData(data, len)) {
+        sc = S_LoadOggSound(s, data, len);
+        goto fail;
+    }
+
     iff_data = data;
     iff_end = data + len;
     if (!GetWavinfo()) {
@@ -176,6 +176,28 @@ static void Paint16(channel_t *ch, sfxcache_t *sc, int count, samplepair_t *samp
     ch->pos += count;
 }
 
+static void PaintStream(channel_t *ch, sfxcache_t *sc, int count, samplepair_t *samp)
+{
+    int16_t buffer[PAINTBUFFER_SIZE];
+    int data;
+    int leftvol, rightvol;
+    int i;
+
+    // decode and resample the next part of the stream
+    OGG_ReadSfxStream(ch, buffer, ch->pos, count, dma.speed);
+
+    leftvol = ch->leftvol * snd_vol;
+    rightvol = ch->rightvol * snd_vol;
+
+    for (i = 0; i < count; i++, samp++) {
+        data = buffer[i];
+        samp->left += (data * leftvol) >> 8;
+        samp->right += (data * rightvol) >> 8;
+    }
+
+    ch->pos += count;
+}
+
 void S_PaintChannels(int endTime)
 {
     samplepair_t paintbuffer[PAINTBUFFER_SIZE];
@@ -232,7 +254,9 @@ void S_PaintChannels(int endTime)
 
                 if (count > 0 && ch->sfx) {
                     samplepair_t *samp = &paintbuffer[ltime - paintedtime];
-                    if (sc->width == 1)
+                    if (sc->streamed)
+                        PaintStream(ch, sc, count, samp);
+                    else if (sc->width == 1)
                         Paint8(ch, sc, count, samp);
                     else
                         Paint16(ch, sc, count, samp);
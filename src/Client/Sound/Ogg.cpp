@@ -646,6 +646,257 @@ static void ogg_enable_changed(cvar_t *self)
 }
 
 
+// --------
+
+/*
+ * Ogg Vorbis sound effects. See Sound.h for how they are loaded,
+ * the decoders below serve the streamed ones. Every channel owns
+ * at most one decoder, which caches the sfx it was opened for and
+ * a ring buffer of decoded samples. The channel position passed
+ * in is authoritative: anything not in the ring buffer is decoded
+ * on demand, and jumps (loops, restarts, reused channels) seek.
+ */
+
+typedef struct {
+	sfx_t *sfx;                                  /* Sound the decoder was opened for. */
+	stb_vorbis *vorbis;                          /* Decoder over the sfxcache data. */
+	int16_t ring[SFX_STREAM_RING_SAMPLES];       /* Decoded mono source samples. */
+	int ringstart;                               /* Source sample index of the oldest sample in the ring. */
+	int ringend;                                 /* Source sample index past the newest sample in the ring. */
+} sfxstream_t;
+
+static sfxstream_t *sfx_streams[MAX_CHANNELS];
+
+/*
+ * Checks for the Ogg page magic.
+ */
+qboolean
+OGG_IsSfxData(const byte *data, size_t len)
+{
+	return len >= 4 && !memcmp(data, "OggS", 4);
+}
+
+/*
+ * Fills in s_info for a sound effect, samples are always
+ * delivered as 16 bit mono.
+ */
+qboolean
+OGG_GetSfxInfo(const byte *data, size_t len)
+{
+	int res = 0;
+	stb_vorbis *vorbis = stb_vorbis_open_memory(data, len, &res, NULL);
+
+	if (!vorbis)
+	{
+		Com_DPrintf("%s is not a valid Ogg Vorbis file (error %i)\n", s_info.name, res);
+		return false;
+	}
+
+	stb_vorbis_info info = stb_vorbis_get_info(vorbis);
+
+	s_info.rate = info.sample_rate;
+	s_info.width = 2;
+	s_info.loopstart = -1;
+	s_info.samples = stb_vorbis_stream_length_in_samples(vorbis);
+
+	stb_vorbis_close(vorbis);
+
+	if (s_info.rate < 8000 || s_info.rate > 48000)
+	{
+		Com_DPrintf("%s has bad rate\n", s_info.name);
+		return false;
+	}
+
+	if (s_info.samples <= 0)
+	{
+		Com_DPrintf("%s has zero length\n", s_info.name);
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ * Decodes a whole sound effect, downmixed to 16 bit mono.
+ * Expects s_info to be filled in by OGG_GetSfxInfo.
+ */
+byte *
+OGG_DecodeSfx(const byte *data, size_t len)
+{
+	int res = 0;
+	stb_vorbis *vorbis = stb_vorbis_open_memory(data, len, &res, NULL);
+
+	if (!vorbis)
+	{
+		return NULL;
+	}
+
+	int16_t *samples = (int16_t *)S_Malloc(s_info.samples * sizeof(int16_t));
+	int total = 0;
+
+	while (total < s_info.samples)
+	{
+		int read = stb_vorbis_get_samples_short_interleaved(vorbis, 1, samples + total, s_info.samples - total);
+
+		if (read <= 0)
+		{
+			break;
+		}
+
+		total += read;
+	}
+
+	stb_vorbis_close(vorbis);
+
+	// pad out anything the decoder didn't deliver
+	if (total < s_info.samples)
+	{
+		memset(samples + total, 0, (s_info.samples - total) * sizeof(int16_t));
+	}
+
+	return (byte *)samples;
+}
+
+static void
+OGG_CloseSfxStream(sfxstream_t *stream)
+{
+	if (stream->vorbis)
+	{
+		stb_vorbis_close(stream->vorbis);
+	}
+
+	stream->vorbis = NULL;
+	stream->sfx = NULL;
+}
+
+/*
+ * Makes sure the ring buffer of the stream holds source sample 'index'.
+ * Returns false once the end of the stream has been reached.
+ */
+static qboolean
+OGG_FillSfxStream(sfxstream_t *stream, int index)
+{
+	// jumped backwards or too far ahead, seek instead of decoding everything in between
+	if (index < stream->ringstart || index >= stream->ringend + SFX_STREAM_RING_SAMPLES)
+	{
+		if (!stb_vorbis_seek(stream->vorbis, index))
+		{
+			return false;
+		}
+
+		stream->ringstart = stream->ringend = index;
+	}
+
+	while (index >= stream->ringend)
+	{
+		int16_t chunk[1024];
+		int read = stb_vorbis_get_samples_short_interleaved(stream->vorbis, 1, chunk, Q_COUNTOF(chunk));
+
+		if (read <= 0)
+		{
+			return false;
+		}
+
+		for (int i = 0; i < read; i++)
+		{
+			stream->ring[(stream->ringend + i) & (SFX_STREAM_RING_SAMPLES - 1)] = chunk[i];
+		}
+
+		stream->ringend += read;
+
+		if (stream->ringend - stream->ringstart > SFX_STREAM_RING_SAMPLES)
+		{
+			stream->ringstart = stream->ringend - SFX_STREAM_RING_SAMPLES;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Reads 'count' samples starting at output sample 'pos' of the
+ * channel's streamed sound effect, resampled to 'outrate'. Past
+ * the end of the sound, or on decoder errors, silence is returned.
+ */
+void
+OGG_ReadSfxStream(channel_t *ch, int16_t *out, int pos, int count, int outrate)
+{
+	sfxcache_t *sc = ch->sfx ? ch->sfx->cache : NULL;
+	int index = ch - channels;
+
+	if (!sc || !sc->streamed || index < 0 || index >= MAX_CHANNELS)
+	{
+		memset(out, 0, count * sizeof(*out));
+		return;
+	}
+
+	if (!sfx_streams[index])
+	{
+		sfx_streams[index] = (sfxstream_t *)S_Malloc(sizeof(sfxstream_t));
+		memset(sfx_streams[index], 0, sizeof(sfxstream_t));
+	}
+
+	sfxstream_t *stream = sfx_streams[index];
+
+	// (re)open the decoder if the channel started playing something else
+	if (stream->sfx != ch->sfx || !stream->vorbis)
+	{
+		int res = 0;
+
+		OGG_CloseSfxStream(stream);
+
+		stream->vorbis = stb_vorbis_open_memory(sc->data, sc->datasize, &res, NULL);
+		if (!stream->vorbis)
+		{
+			memset(out, 0, count * sizeof(*out));
+			return;
+		}
+
+		stream->sfx = ch->sfx;
+		stream->ringstart = stream->ringend = 0;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		int src = (int)((int64_t)(pos + i) * sc->rate / outrate);
+
+		if (src >= sc->numsamples || !OGG_FillSfxStream(stream, src))
+		{
+			memset(out + i, 0, (count - i) * sizeof(*out));
+			return;
+		}
+
+		out[i] = stream->ring[src & (SFX_STREAM_RING_SAMPLES - 1)];
+	}
+}
+
+/*
+ * Releases the decoders playing 'sfx', or all of them if NULL.
+ */
+void
+OGG_CloseSfxStreams(sfx_t *sfx)
+{
+	for (int i = 0; i < MAX_CHANNELS; i++)
+	{
+		sfxstream_t *stream = sfx_streams[i];
+
+		if (!stream || (sfx && stream->sfx != sfx))
+		{
+			continue;
+		}
+
+		OGG_CloseSfxStream(stream);
+
+		if (!sfx)
+		{
+			Z_Free(stream);
+			sfx_streams[i] = NULL;
+		}
+	}
+}
+
+// --------
+
 /*
  * Initialize the Ogg Vorbis subsystem.
  */
@@ -39,11 +39,16 @@ void AL_InitUnderwaterFilter(void);
 // OpenAL implementation should support at least this number of sources
 #define MIN_CHANNELS 16
 
+// streamed sound effects keep this many buffers of this many samples queued per source
+#define AL_SFX_STREAM_BUFFERS   4
+#define AL_SFX_STREAM_SAMPLES   4096
+
 int active_buffers = 0;
 int active_voice_buffers = 0;
 qboolean streamPlaying = false;
 qboolean voicePlaying = false;
 static ALuint s_srcnums[MAX_CHANNELS];
+static ALuint s_streambufs[MAX_CHANNELS][AL_SFX_STREAM_BUFFERS];
 static ALuint streamSource = 0;
 static ALuint voiceSource = 0;
 static int s_framecount;
@@ -696,6 +701,13 @@ void AL_Shutdown(void)
 	qalDeleteEffects(1, &ReverbEffect);
 	qalDeleteAuxiliaryEffectSlots(1, &ReverbEffectSlot);
 
+	for (int i = 0; i < MAX_CHANNELS; i++) {
+		if (s_streambufs[i][0]) {
+			qalDeleteBuffers(AL_SFX_STREAM_BUFFERS, s_streambufs[i]);
+		}
+	}
+	memset(s_streambufs, 0, sizeof(s_streambufs));
+
 	if (s_numchannels) {
 		// delete source names
 		qalDeleteSources(s_numchannels, s_srcnums);
@@ -849,19 +861,100 @@ void AL_StopChannel(channel_t *ch)
 	memset(ch, 0, sizeof(*ch));
 }
 
+/*
+* Decodes the next part of a streamed sound effect into 'buffer' and queues
+* it on the channel's source. Autosounds wrap around, others run out.
+*/
+static qboolean AL_QueueStreamBuffer(channel_t *ch, sfxcache_t *sc, ALuint buffer)
+{
+	int16_t samples[AL_SFX_STREAM_SAMPLES];
+	int count;
+
+	if (ch->pos >= sc->numsamples) {
+		if (!ch->autosound)
+			return false;
+		ch->pos = 0;
+	}
+
+	count = min(sc->numsamples - ch->pos, AL_SFX_STREAM_SAMPLES);
+
+	// channel positions are in source samples here, OpenAL takes care of resampling
+	OGG_ReadSfxStream(ch, samples, ch->pos, count, sc->rate);
+	ch->pos += count;
+
+	qalBufferData(buffer, AL_FORMAT_MONO16, samples, count * sizeof(int16_t), sc->rate);
+	qalSourceQueueBuffers(ch->srcnum, 1, &buffer);
+
+	return true;
+}
+
+/*
+* Refills the processed buffers of a streamed sound effect.
+* Returns false once it has played out completely.
+*/
+static qboolean AL_UpdateStreamChannel(channel_t *ch)
+{
+	sfxcache_t *sc = ch->sfx->cache;
+	ALint processed = 0, queued = 0;
+	ALint state;
+
+	if (!sc || !sc->streamed)
+		return true;
+
+	qalGetSourcei(ch->srcnum, AL_BUFFERS_PROCESSED, &processed);
+	while (processed-- > 0) {
+		ALuint buffer;
+		qalSourceUnqueueBuffers(ch->srcnum, 1, &buffer);
+		AL_QueueStreamBuffer(ch, sc, buffer);
+	}
+
+	qalGetSourcei(ch->srcnum, AL_BUFFERS_QUEUED, &queued);
+	qalGetSourcei(ch->srcnum, AL_SOURCE_STATE, &state);
+
+	if (state == AL_STOPPED) {
+		// nothing left at all
+		if (!queued)
+			return false;
+
+		// the decoder couldn't keep up, resume
+		qalSourcePlay(ch->srcnum);
+	}
+
+	return true;
+}
+
 void AL_PlayChannel(channel_t *ch)
 {
 	sfxcache_t *sc = ch->sfx->cache;
+	int index = ch - channels;
 
 #ifdef _DEBUG
 	if (s_show->integer > 1)
 		Com_Printf("%s: %s\n", __func__, ch->sfx->name);
 #endif
 
-	ch->srcnum = s_srcnums[ch - channels];
+	ch->srcnum = s_srcnums[index];
 	qalGetError();
-	qalSourcei(ch->srcnum, AL_BUFFER, sc->bufnum);
-	if (ch->autosound /*|| sc->loopstart >= 0*/) {
+	if (sc->streamed) {
+		// queue up the first few buffers, AL_Update keeps them coming
+		if (!s_streambufs[index][0]) {
+			qalGenBuffers(AL_SFX_STREAM_BUFFERS, s_streambufs[index]);
+		}
+
+		qalSourcei(ch->srcnum, AL_BUFFER, AL_NONE);
+		qalSourcei(ch->srcnum, AL_LOOPING, AL_FALSE);
+
+		ch->pos = 0;
+		for (int i = 0; i < AL_SFX_STREAM_BUFFERS; i++) {
+			if (!AL_QueueStreamBuffer(ch, sc, s_streambufs[index][i]))
+				break;
+		}
+	} else {
+		qalSourcei(ch->srcnum, AL_BUFFER, sc->bufnum);
+	}
+	if (sc->streamed) {
+		// looping is done by the decoder
+	} else if (ch->autosound /*|| sc->loopstart >= 0*/) {
 		qalSourcei(ch->srcnum, AL_LOOPING, AL_TRUE);
 	}
 	else {
@@ -1175,6 +1268,15 @@ void AL_Update(void)
 				AL_StopChannel(ch);
 				continue;
 			}
+
+			AL_UpdateStreamChannel(ch);
+		}
+		else if (ch->sfx->cache && ch->sfx->cache->streamed) {
+			// streamed sounds stop once the decoder ran dry
+			if (!AL_UpdateStreamChannel(ch)) {
+				AL_StopChannel(ch);
+				continue;
+			}
 		}
 		else {
 			ALenum state;
@@ -76,6 +76,10 @@ typedef struct sfxcache_s {
     int         size;
     int         bufnum;
 #endif
+    qboolean    streamed;       // data holds compressed Ogg Vorbis, decoded per channel
+    int         rate;           // streamed: source sample rate
+    int         numsamples;     // streamed: total number of source samples
+    int         datasize;       // streamed: size of the compressed data
     byte        data[1];        // variable sized
 } sfxcache_t;
 
@@ -216,6 +220,7 @@ extern cvar_t   *s_testsound;
 
 extern cvar_t   *s_ambient;
 extern cvar_t   *s_show;
+extern cvar_t   *s_stream_threshold;
 
 #define S_Malloc(x)     Z_TagMalloc(x, TAG_SOUND)
 #define S_CopyString(x) Z_TagCopyString(x, TAG_SOUND)
@@ -232,3 +237,25 @@ void S_InitScaletable(void);
 void S_PaintChannels(int endTime);
 #endif // #if USE_SNDDMA
 
+/*
+====================================================================
+
+  OGG VORBIS SOUND EFFECTS
+
+  Short sounds are decoded up front and uploaded like any WAV file.
+  Sounds longer than s_stream_threshold seconds keep their compressed
+  data in the sfxcache instead, and each channel playing one decodes it
+  incrementally into a small ring buffer.
+
+====================================================================
+*/
+
+// decoded mono samples kept around per streaming channel, must be a power of two
+#define SFX_STREAM_RING_SAMPLES     8192
+
+qboolean OGG_IsSfxData(const byte *data, size_t len);
+qboolean OGG_GetSfxInfo(const byte *data, size_t len);
+byte *OGG_DecodeSfx(const byte *data, size_t len);
+void OGG_ReadSfxStream(channel_t *ch, int16_t *out, int pos, int count, int outrate);
+void OGG_CloseSfxStreams(sfx_t *sfx);
+
@@ -36,6 +36,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 extern CollisionModel collisionModel;
 
 static cvar_t *map_visibility_patch;
+static cvar_t *map_cooked;
 
 /*
 ===============================================================================
@@ -1320,6 +1321,17 @@ void BSP_Free(bsp_t *bsp)
 			Z_Free(bsp->pvs2_matrix);
 			bsp->pvs2_matrix = NULL;
 		}
+		if (bsp->pvs_matrix)
+		{
+			// same goes for the PVS and PHS matrices
+			Z_Free(bsp->pvs_matrix);
+			bsp->pvs_matrix = NULL;
+		}
+		if (bsp->phs_matrix)
+		{
+			Z_Free(bsp->phs_matrix);
+			bsp->phs_matrix = NULL;
+		}
 
         Hunk_Free(&bsp->hunk);
         List_Remove(&bsp->entry);
@@ -1345,6 +1357,22 @@ static void BSP_BuildPvsMatrix(bsp_t* bsp) {
     bsp->pvs_matrix = pvs_matrix;
 }
 
+static void BSP_BuildPhsMatrix(bsp_t* bsp) {
+    if (!bsp->vis)
+        return;
+
+    size_t matrix_size = bsp->visrowsize * bsp->vis->numclusters;
+
+    // same as for the PVS, BSP_ClusterVis has to decompress the PHS rows before we set the matrix
+    byte* phs_matrix = (byte*)Z_Mallocz(matrix_size);
+
+    for (int cluster = 0; cluster < bsp->vis->numclusters; cluster++) 	{
+        BSP_ClusterVis(bsp, phs_matrix + bsp->visrowsize * cluster, cluster, DVIS_PHS);
+    }
+
+    bsp->phs_matrix = phs_matrix;
+}
+
 byte* BSP_GetPvs(bsp_t* bsp, int cluster) {
     if (!bsp->vis || !bsp->pvs_matrix)
         return NULL;
@@ -1355,6 +1383,16 @@ byte* BSP_GetPvs(bsp_t* bsp, int cluster) {
     return bsp->pvs_matrix + bsp->visrowsize * cluster;
 }
 
+byte* BSP_GetPhs(bsp_t* bsp, int cluster) {
+    if (!bsp->vis || !bsp->phs_matrix)
+        return NULL;
+
+    if (cluster < 0 || cluster >= bsp->vis->numclusters)
+        return NULL;
+
+    return bsp->phs_matrix + bsp->visrowsize * cluster;
+}
+
 byte* BSP_GetPvs2(bsp_t* bsp, int cluster) {
     if (!bsp->vis || !bsp->pvs2_matrix)
         return NULL;
@@ -1365,8 +1403,8 @@ byte* BSP_GetPvs2(bsp_t* bsp, int cluster) {
     return bsp->pvs2_matrix + bsp->visrowsize * cluster;
 }
 
-// Converts `maps/<name>.bsp` into `maps/pvs/<name>.bin`
-static qboolean BSP_GetPatchedPVSFileName(const char* map_path, char pvs_path[MAX_QPATH]) {
+// Converts `maps/<name>.bsp` into `maps/<subdir>/<name>.bin`
+static qboolean BSP_GetSidecarFileName(const char* map_path, const char* subdir, char out_path[MAX_QPATH]) {
     int path_len = strlen(map_path);
     if (path_len < 5 || strcmp(map_path + path_len - 4, ".bsp") != 0)
         return false;
@@ -1377,15 +1415,24 @@ static qboolean BSP_GetPatchedPVSFileName(const char* map_path, char pvs_path[MA
     else
         map_file = map_path;
 
-    memset(pvs_path, 0, MAX_QPATH);
-    strncpy(pvs_path, map_path, map_file - map_path);
-    strcat(pvs_path, "pvs/");
-    strncat(pvs_path, map_file, strlen(map_file) - 4);
-    strcat(pvs_path, ".bin");
+    if ((map_file - map_path) + strlen(subdir) + 1 + strlen(map_file) >= MAX_QPATH)
+        return false;
+
+    memset(out_path, 0, MAX_QPATH);
+    strncpy(out_path, map_path, map_file - map_path);
+    strcat(out_path, subdir);
+    strcat(out_path, "/");
+    strncat(out_path, map_file, strlen(map_file) - 4);
+    strcat(out_path, ".bin");
 
     return true;
 }
 
+// Converts `maps/<name>.bsp` into `maps/pvs/<name>.bin`
+static qboolean BSP_GetPatchedPVSFileName(const char* map_path, char pvs_path[MAX_QPATH]) {
+    return BSP_GetSidecarFileName(map_path, "pvs", pvs_path);
+}
+
 // Loads the first- and second-order PVS matrices from a file called `maps/pvs/<mapname>.bin`
 static qboolean BSP_LoadPatchedPVS(bsp_t* bsp) {
     char pvs_path[MAX_QPATH];
@@ -1416,6 +1463,196 @@ static qboolean BSP_LoadPatchedPVS(bsp_t* bsp) {
     return true;
 }
 
+/*
+===============================================================================
+
+                    COOKED BSP SIDECAR
+
+The cooked sidecar `maps/cooked/<mapname>.bin` stores all data that BSP_Load
+would otherwise derive from the lumps on every load: the decompressed PVS and
+PHS matrices, and the second-order PVS matrix (once the renderer has patched it).
+The node/leaf parents are not cooked: BSP_ValidateTree sets them up while it
+checks the tree for loops, and it keeps doing so on every load, so that a
+damaged sidecar can never introduce a parent cycle.
+
+It is tied to the exact BSP file by its checksum, and is read back with a
+single FS_LoadFile call. The layout is a header followed by a BSPX style lump
+directory, so new lumps can be added without breaking older readers.
+
+===============================================================================
+*/
+
+#define COOKED_IDENT        (('K' << 24) + ('O' << 16) + ('O' << 8) + 'C')
+#define COOKED_VERSION      2
+
+#define COOKED_FLAG_VISIBILITY_PATCH    (1 << 0)
+
+typedef struct {
+    uint32_t    ident;
+    uint32_t    version;
+    uint32_t    checksum;       // must match bsp->checksum
+    uint32_t    flags;          // COOKED_FLAG_* state at cooking time
+    uint32_t    numclusters;
+    uint32_t    visrowsize;
+    uint32_t    numnodes;
+    uint32_t    numleafs;
+    uint32_t    numlumps;       // followed by bspx_lump_t[numlumps]
+} cooked_header_t;
+
+static uint32_t BSP_CookedFlags(void) {
+    return map_visibility_patch->integer ? COOKED_FLAG_VISIBILITY_PATCH : 0;
+}
+
+// Validates and returns the named lump out of a loaded cooked sidecar
+static const void* BSP_FindCookedLump(const byte* filebuf, size_t filelen, const char* name, size_t expected_size) {
+    const cooked_header_t* header = (const cooked_header_t*)filebuf;
+    const bspx_lump_t* lumps = (const bspx_lump_t*)(header + 1);
+
+    for (uint32_t i = 0; i < header->numlumps; i++) {
+        if (strncmp(name, lumps[i].lumpname, sizeof(lumps[i].lumpname) - 1) != 0)
+            continue;
+
+        if ((size_t)lumps[i].fileofs + lumps[i].filelen > filelen || lumps[i].filelen != expected_size) {
+            Com_WPrintf("Malformed cooked BSP file: lump '%s' has a bad extent\n", name);
+            return NULL;
+        }
+
+        return filebuf + lumps[i].fileofs;
+    }
+
+    return NULL;
+}
+
+// Loads the derived BSP data from `maps/cooked/<mapname>.bin`, replacing
+// BSP_LoadPatchedPVS, BSP_BuildPvsMatrix and BSP_BuildPhsMatrix
+static qboolean BSP_LoadCooked(bsp_t* bsp) {
+    char cooked_path[MAX_QPATH];
+
+    if (!map_cooked->integer)
+        return false;
+
+    if (!BSP_GetSidecarFileName(bsp->name, "cooked", cooked_path))
+        return false;
+
+    byte* filebuf = NULL;
+    ssize_t filelen = FS_LoadFile(cooked_path, (void**)&filebuf);
+
+    if (!filebuf)
+        return false;
+
+    const cooked_header_t* header = (const cooked_header_t*)filebuf;
+    const uint32_t numclusters = bsp->vis ? bsp->vis->numclusters : 0;
+
+    if (filelen < (ssize_t)sizeof(*header)
+        || header->ident != COOKED_IDENT
+        || header->version != COOKED_VERSION
+        || header->checksum != bsp->checksum
+        || header->flags != BSP_CookedFlags()
+        || header->numclusters != numclusters
+        || header->visrowsize != (uint32_t)bsp->visrowsize
+        || header->numnodes != (uint32_t)bsp->numnodes
+        || header->numleafs != (uint32_t)bsp->numleafs
+        || sizeof(*header) + sizeof(bspx_lump_t) * (size_t)header->numlumps > (size_t)filelen) {
+        FS_FreeFile(filebuf);
+        return false;
+    }
+
+    const size_t matrix_size = bsp->visrowsize * numclusters;
+    const byte* pvs = (const byte*)BSP_FindCookedLump(filebuf, filelen, "PVSMATRIX", matrix_size);
+    const byte* phs = (const byte*)BSP_FindCookedLump(filebuf, filelen, "PHSMATRIX", matrix_size);
+    const byte* pvs2 = (const byte*)BSP_FindCookedLump(filebuf, filelen, "PVS2MATRIX", matrix_size);
+
+    if (matrix_size && (!pvs || !phs)) {
+        FS_FreeFile(filebuf);
+        return false;
+    }
+
+    if (matrix_size) {
+        bsp->pvs_matrix = (byte*)Z_Malloc(matrix_size);
+        memcpy(bsp->pvs_matrix, pvs, matrix_size);
+
+        bsp->phs_matrix = (byte*)Z_Malloc(matrix_size);
+        memcpy(bsp->phs_matrix, phs, matrix_size);
+
+        if (pvs2) {
+            bsp->pvs2_matrix = (byte*)Z_Malloc(matrix_size);
+            memcpy(bsp->pvs2_matrix, pvs2, matrix_size);
+            bsp->pvs_patched = true;
+        }
+    }
+
+    FS_FreeFile(filebuf);
+    return true;
+}
+
+// Saves the derived BSP data to `maps/cooked/<mapname>.bin`
+static qboolean BSP_SaveCooked(bsp_t* bsp) {
+    char cooked_path[MAX_QPATH];
+
+    if (!map_cooked->integer)
+        return false;
+
+    if (!BSP_GetSidecarFileName(bsp->name, "cooked", cooked_path))
+        return false;
+
+    const uint32_t numclusters = bsp->vis ? bsp->vis->numclusters : 0;
+    const size_t matrix_size = bsp->visrowsize * numclusters;
+
+    if (matrix_size && (!bsp->pvs_matrix || !bsp->phs_matrix))
+        return false;
+
+    // gather the lumps
+    struct {
+        const char* name;
+        const void* data;
+        size_t size;
+    } lumps[3];
+    uint32_t numlumps = 0;
+
+    if (matrix_size) {
+        lumps[numlumps++] = { "PVSMATRIX", bsp->pvs_matrix, matrix_size };
+        lumps[numlumps++] = { "PHSMATRIX", bsp->phs_matrix, matrix_size };
+        if (bsp->pvs_patched && bsp->pvs2_matrix) {
+            lumps[numlumps++] = { "PVS2MATRIX", bsp->pvs2_matrix, matrix_size };
+        }
+    }
+
+    // lay out the file, keeping every lump 4 byte aligned
+    size_t filelen = sizeof(cooked_header_t) + sizeof(bspx_lump_t) * numlumps;
+    size_t offsets[3];
+    for (uint32_t i = 0; i < numlumps; i++) {
+        offsets[i] = filelen;
+        filelen += (lumps[i].size + 3) & ~(size_t)3;
+    }
+
+    byte* filebuf = (byte*)Z_Mallocz(filelen);
+
+    cooked_header_t* header = (cooked_header_t*)filebuf;
+    header->ident = COOKED_IDENT;
+    header->version = COOKED_VERSION;
+    header->checksum = bsp->checksum;
+    header->flags = BSP_CookedFlags();
+    header->numclusters = numclusters;
+    header->visrowsize = bsp->visrowsize;
+    header->numnodes = bsp->numnodes;
+    header->numleafs = bsp->numleafs;
+    header->numlumps = numlumps;
+
+    bspx_lump_t* directory = (bspx_lump_t*)(header + 1);
+    for (uint32_t i = 0; i < numlumps; i++) {
+        Q_strlcpy(directory[i].lumpname, lumps[i].name, sizeof(directory[i].lumpname));
+        directory[i].fileofs = offsets[i];
+        directory[i].filelen = lumps[i].size;
+        memcpy(filebuf + offsets[i], lumps[i].data, lumps[i].size);
+    }
+
+    qerror_t err = FS_WriteFile(cooked_path, filebuf, filelen);
+
+    Z_Free(filebuf);
+
+    return err >= 0;
+}
+
 // Saves the first- and second-order PVS matrices to a file called `maps/pvs/<mapname>.bin`
 qboolean BSP_SavePatchedPVS(bsp_t* bsp) {
     char pvs_path[MAX_QPATH];
@@ -1439,6 +1676,12 @@ qboolean BSP_SavePatchedPVS(bsp_t* bsp) {
 
     Z_Free(filebuf);
 
+    // the renderer only patches the PVS once, store the result in the cooked sidecar as well
+    if (err >= 0) {
+        bsp->pvs_patched = true;
+        BSP_SaveCooked(bsp);
+    }
+
     if (err >= 0)
         return true;
     else
@@ -1663,14 +1906,26 @@ qerror_t BSP_Load(const char *name, bsp_t **bsp_p)
         goto fail1;
     }
 
-	if (!BSP_LoadPatchedPVS(bsp))
-	{
-			BSP_BuildPvsMatrix(bsp);
-	}
-	else
-	{
-		bsp->pvs_patched = true;
-	}
+    if (!BSP_LoadCooked(bsp)) {
+	    if (!BSP_LoadPatchedPVS(bsp))
+	    {
+			    BSP_BuildPvsMatrix(bsp);
+	    }
+	    else
+	    {
+		    bsp->pvs_patched = true;
+	    }
+
+        // when cooking, decompress the PHS up front as well and cook it all for
+        // the next load, otherwise BSP_ClusterVis decompresses PHS rows on demand
+        if (map_cooked->integer) {
+            BSP_BuildPhsMatrix(bsp);
+
+            if (!BSP_SaveCooked(bsp)) {
+                Com_DPrintf("Couldn't save cooked BSP data for %s\n", bsp->name);
+            }
+        }
+    }
 #if USE_REF
     if (normal_lump_size) {
         BSP_LoadBspxNormals(bsp, normal_lump_data, normal_lump_size);
@@ -1849,6 +2104,13 @@ byte *BSP_ClusterVis(bsp_t *bsp, byte *mask, int cluster, int vis)
 		return mask;
 	}
 
+	if (vis == DVIS_PHS && bsp->phs_matrix)
+	{
+        byte* row = BSP_GetPhs(bsp, cluster);
+		memcpy(mask, row, bsp->visrowsize);
+		return mask;
+	}
+
     // decompress vis
     in_end = (byte *)bsp->vis + bsp->numvisibility;
     in = (byte *)bsp->vis + bsp->vis->bitofs[cluster][vis];
@@ -1955,6 +2217,7 @@ mmodel_t *BSP_InlineModel(bsp_t *bsp, const char *name)
 void BSP_Init(void)
 {
     map_visibility_patch = Cvar_Get("map_visibility_patch", "1", 0);
+    map_cooked = Cvar_Get("map_cooked", "0", 0);
 
     Cmd_AddCommand("bsplist", BSP_List_f);
 
@@ -300,6 +300,7 @@ typedef struct bsp_s {
 #endif
 
     byte            *pvs_matrix;
+    byte            *phs_matrix;
     byte            *pvs2_matrix;
 	qboolean        pvs_patched;
 
@@ -331,6 +332,7 @@ mleaf_t *BSP_PointLeaf(mnode_t *node, const vec3_t &p);
 mmodel_t *BSP_InlineModel(bsp_t *bsp, const char *name);
 
 byte* BSP_GetPvs(bsp_t *bsp, int cluster);
+byte* BSP_GetPhs(bsp_t *bsp, int cluster);
 byte* BSP_GetPvs2(bsp_t *bsp, int cluster);
 
 qboolean BSP_SavePatchedPVS(bsp_t *bsp);
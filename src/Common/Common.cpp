@@ -50,6 +50,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include "System/System.h"
 
 #include <setjmp.h>
+#include <atomic>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -65,6 +66,8 @@ static char     com_errorMsg[MAXERRORMSG]; // from Com_Printf/Com_Error
 
 static int      com_printEntered;
 
+static std::thread::id  com_mainThread;    // thread that runs the frames, set in Qcommon_Init
+
 static qhandle_t    com_logFile;
 static qboolean     com_logNewline;
 
@@ -391,6 +394,121 @@ char *Com_GetLastError(void)
     return com_errorMsg;
 }
 
+/*
+==============================================================================
+
+THREAD PRINTS
+
+Only the main thread may touch the console, logfile and redirect buffers.
+Prints from any other thread are pushed into a lock-free ring instead, which
+the main thread drains at the start of every frame, and before each of its
+own prints to keep the output in order. Producers never block: when the ring
+is full the message is dropped and counted.
+
+==============================================================================
+*/
+
+#define PRINT_RING_SIZE     256     // must be a power of two
+#define PRINT_RING_MASK     (PRINT_RING_SIZE - 1)
+#define PRINT_RING_MSGLEN   1024    // longer messages are truncated
+
+typedef struct {
+    // equals the ring position once free to be claimed by a producer,
+    // and position + 1 once the message has been written
+    std::atomic<uint32_t>   sequence;
+    int32_t printType;
+    char    text[PRINT_RING_MSGLEN];
+} printSlot_t;
+
+static printSlot_t              com_printRing[PRINT_RING_SIZE];
+static std::atomic<uint32_t>    com_printRingHead;     // next position to claim
+static uint32_t                 com_printRingTail;     // next position to drain, main thread only
+static std::atomic<uint32_t>    com_printRingDropped;
+
+static void Com_InitThreadPrints(void)
+{
+    for (uint32_t i = 0; i < PRINT_RING_SIZE; i++) {
+        com_printRing[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    com_printRingHead.store(0, std::memory_order_relaxed);
+    com_printRingTail = 0;
+    com_printRingDropped.store(0, std::memory_order_relaxed);
+
+    com_mainThread = std::this_thread::get_id();
+}
+
+static inline qboolean Com_IsMainThread(void)
+{
+    // everything runs on the main thread before Qcommon_Init
+    return com_mainThread == std::thread::id() || com_mainThread == std::this_thread::get_id();
+}
+
+static void Com_PushThreadPrint(int32_t printType, const char *msg)
+{
+    printSlot_t *slot;
+    uint32_t    pos;
+    int32_t     diff;
+
+    pos = com_printRingHead.load(std::memory_order_relaxed);
+    while (1) {
+        slot = &com_printRing[pos & PRINT_RING_MASK];
+        diff = (int32_t)(slot->sequence.load(std::memory_order_acquire) - pos);
+        if (diff == 0) {
+            // slot is free, try to claim it
+            if (com_printRingHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // ring is full, the main thread hasn't caught up yet
+            com_printRingDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            // another producer claimed it first
+            pos = com_printRingHead.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->printType = printType;
+    Q_strlcpy(slot->text, msg, sizeof(slot->text));
+    slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+static void Com_OutputPrint(int32_t printType, char *msg, size_t len);
+
+/*
+=============
+Com_FlushThreadPrints
+
+Outputs the messages that were printed by other threads.
+Must be called from the main thread.
+=============
+*/
+static void Com_FlushThreadPrints(void)
+{
+    printSlot_t *slot;
+    uint32_t    dropped;
+
+    while (1) {
+        slot = &com_printRing[com_printRingTail & PRINT_RING_MASK];
+        if (slot->sequence.load(std::memory_order_acquire) != com_printRingTail + 1) {
+            break;
+        }
+
+        Com_OutputPrint(slot->printType, slot->text, strlen(slot->text));
+
+        // hand the slot back to the producers for the next lap
+        slot->sequence.store(com_printRingTail + PRINT_RING_SIZE, std::memory_order_release);
+        com_printRingTail++;
+    }
+
+    dropped = com_printRingDropped.exchange(0, std::memory_order_relaxed);
+    if (dropped) {
+        char msg[MAX_QPATH];
+        size_t len = Q_scnprintf(msg, sizeof(msg), "%u thread prints were dropped\n", dropped);
+        Com_OutputPrint(PrintType::Warning, msg, len);
+    }
+}
+
 /*
 =============
 Com_Printf
@@ -405,17 +523,36 @@ void Com_LPrintf(int32_t printType, const char *fmt, ...)
     char        msg[MAXPRINTMSG];
     size_t      len;
 
+    if (!Com_IsMainThread()) {
+        va_start(argptr, fmt);
+        Q_vsnprintf(msg, sizeof(msg), fmt, argptr);
+        va_end(argptr);
+
+        Com_PushThreadPrint(printType, msg);
+        return;
+    }
+
     // may be entered recursively only once
     if (com_printEntered >= 2) {
         return;
     }
 
-    com_printEntered++;
-
     va_start(argptr, fmt);
     len = Q_vscnprintf(msg, sizeof(msg), fmt, argptr);
     va_end(argptr);
 
+    // keep the order with what other threads printed before
+    if (!com_printEntered) {
+        Com_FlushThreadPrints();
+    }
+
+    Com_OutputPrint(printType, msg, len);
+}
+
+static void Com_OutputPrint(int32_t printType, char *msg, size_t len)
+{
+    com_printEntered++;
+
     if (printType == PrintType::Error && !com_errorEntered && len) {
         size_t errlen = len;
 
@@ -901,6 +1038,8 @@ void Qcommon_Init(int argc, char **argv)
     if (setjmp(com_abortframe))
         Sys_Error("Error during initialization: %s", com_errorMsg);
 
+    Com_InitThreadPrints();
+
     com_argc = argc;
     com_argv = argv;
 
@@ -1096,6 +1235,9 @@ void Qcommon_Frame(void)
         return;            // an ErrorType::Drop was thrown
     }
 
+    // output what other threads printed since the last frame
+    Com_FlushThreadPrints();
+
 #if USE_CLIENT
     timeBefore = timeEvent = timeBetween = timeAfter = 0;
 
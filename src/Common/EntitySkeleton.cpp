@@ -17,6 +17,14 @@
 //! Common Internal Skeleton Declarations.
 #include "Common/EntitySkeleton.h"
 
+//! SSE2 is the baseline on x86-64, other targets use the scalar paths.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ES_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define ES_USE_SSE2 0
+#endif
+
 
 
 /**
@@ -28,7 +36,7 @@
 **/
 // "multiply" 3x4 matrices, these are assumed to be the top 3 rows
 // of a 4x4 matrix with the last row = (0 0 0 1)
-static void Matrix34Multiply(const float* a, const float* b, float* out) {
+static inline void Matrix34Multiply_C(const float* a, const float* b, float* out) {
 	out[0] = a[0] * b[0] + a[1] * b[4] + a[2] * b[8];
 	out[1] = a[0] * b[1] + a[1] * b[5] + a[2] * b[9];
 	out[2] = a[0] * b[2] + a[1] * b[6] + a[2] * b[10];
@@ -148,6 +156,267 @@ static vec_t QuatNormalize2(const quat_t &v, quat_t &out) {
 
 
 
+/**
+*
+*
+*	SIMD Pose Kernels: These work on 4 bones at a time, each bone pose component
+*	is stored in SoA form with one bone per lane.
+*
+*
+**/
+#if ES_USE_SSE2
+/**
+*	@brief	4 Bone Poses in SoA form.
+**/
+struct EntitySkeletonBonePoseSoA {
+	//! Translation.
+	__m128 tx, ty, tz;
+	//! Rotation quaternion.
+	__m128 rx, ry, rz, rw;
+	//! Scale.
+	__m128 sx, sy, sz;
+};
+
+/**
+*	@brief	Gathers the 4 bone poses at the given indices into SoA form.
+**/
+static inline void ES_LoadBonePosesSoA( const EntitySkeletonBonePose *poses, const int32_t *indices, EntitySkeletonBonePoseSoA &out ) {
+	const EntitySkeletonBonePose &a = poses[indices[0]];
+	const EntitySkeletonBonePose &b = poses[indices[1]];
+	const EntitySkeletonBonePose &c = poses[indices[2]];
+	const EntitySkeletonBonePose &d = poses[indices[3]];
+
+	out.tx = _mm_setr_ps( a.translate[0], b.translate[0], c.translate[0], d.translate[0] );
+	out.ty = _mm_setr_ps( a.translate[1], b.translate[1], c.translate[1], d.translate[1] );
+	out.tz = _mm_setr_ps( a.translate[2], b.translate[2], c.translate[2], d.translate[2] );
+	out.rx = _mm_setr_ps( a.rotate[0], b.rotate[0], c.rotate[0], d.rotate[0] );
+	out.ry = _mm_setr_ps( a.rotate[1], b.rotate[1], c.rotate[1], d.rotate[1] );
+	out.rz = _mm_setr_ps( a.rotate[2], b.rotate[2], c.rotate[2], d.rotate[2] );
+	out.rw = _mm_setr_ps( a.rotate[3], b.rotate[3], c.rotate[3], d.rotate[3] );
+	out.sx = _mm_setr_ps( a.scale[0], b.scale[0], c.scale[0], d.scale[0] );
+	out.sy = _mm_setr_ps( a.scale[1], b.scale[1], c.scale[1], d.scale[1] );
+	out.sz = _mm_setr_ps( a.scale[2], b.scale[2], c.scale[2], d.scale[2] );
+}
+
+/**
+*	@brief	Scatters 4 SoA bone poses back to the given indices.
+**/
+static inline void ES_StoreBonePosesSoA( const EntitySkeletonBonePoseSoA &in, EntitySkeletonBonePose *poses, const int32_t *indices ) {
+	alignas(16) float t[3][4], r[4][4], s[3][4];
+
+	_mm_store_ps( t[0], in.tx ); _mm_store_ps( t[1], in.ty ); _mm_store_ps( t[2], in.tz );
+	_mm_store_ps( r[0], in.rx ); _mm_store_ps( r[1], in.ry ); _mm_store_ps( r[2], in.rz ); _mm_store_ps( r[3], in.rw );
+	_mm_store_ps( s[0], in.sx ); _mm_store_ps( s[1], in.sy ); _mm_store_ps( s[2], in.sz );
+
+	for ( int32_t i = 0; i < 4; i++ ) {
+		EntitySkeletonBonePose &pose = poses[indices[i]];
+		pose.translate[0] = t[0][i]; pose.translate[1] = t[1][i]; pose.translate[2] = t[2][i];
+		pose.rotate[0] = r[0][i]; pose.rotate[1] = r[1][i]; pose.rotate[2] = r[2][i]; pose.rotate[3] = r[3][i];
+		pose.scale[0] = s[0][i]; pose.scale[1] = s[1][i]; pose.scale[2] = s[2][i];
+	}
+}
+
+/**
+*	@brief	Slerps 4 rotations at once, taking the shortest path just like QuatSlerp does.
+*
+*			Uses the polynomial approximation from Eberly's "A Fast and Accurate Algorithm for
+*			Computing SLERP", which has no trigonometry nor branches. After the shortest path
+*			flip the angle stays within 90 degrees, where it is within ~1e-5 of the exact result.
+**/
+static inline void ES_SlerpRotationsSoA( const EntitySkeletonBonePoseSoA &from, const EntitySkeletonBonePoseSoA &to, const float fraction, EntitySkeletonBonePoseSoA &out ) {
+	static constexpr float onePlusMu = 1.90110745351730037f;
+	static constexpr float u[8] = {
+		1.f / (1 * 3), 1.f / (2 * 5), 1.f / (3 * 7), 1.f / (4 * 9),
+		1.f / (5 * 11), 1.f / (6 * 13), 1.f / (7 * 15), onePlusMu / (8 * 17)
+	};
+	static constexpr float v[8] = {
+		1.f / 3, 2.f / 5, 3.f / 7, 4.f / 9,
+		5.f / 11, 6.f / 13, 7.f / 15, onePlusMu * 8 / 17
+	};
+
+	const __m128 one = _mm_set1_ps( 1.f );
+	const __m128 t = _mm_set1_ps( fraction );
+	const __m128 d = _mm_set1_ps( 1.f - fraction );
+	const __m128 sqrT = _mm_mul_ps( t, t );
+	const __m128 sqrD = _mm_mul_ps( d, d );
+
+	// cos() of angle, flipped to positive for the shortest path.
+	__m128 cosAngle = _mm_add_ps( _mm_add_ps( _mm_mul_ps( from.rx, to.rx ), _mm_mul_ps( from.ry, to.ry ) ),
+								  _mm_add_ps( _mm_mul_ps( from.rz, to.rz ), _mm_mul_ps( from.rw, to.rw ) ) );
+	const __m128 sign = _mm_and_ps( cosAngle, _mm_set1_ps( -0.f ) );
+	cosAngle = _mm_xor_ps( cosAngle, sign );
+	const __m128 xm1 = _mm_sub_ps( cosAngle, one );
+
+	__m128 seriesT = one, seriesD = one;
+	for ( int32_t i = 7; i >= 0; i-- ) {
+		const __m128 bT = _mm_mul_ps( _mm_sub_ps( _mm_mul_ps( _mm_set1_ps( u[i] ), sqrT ), _mm_set1_ps( v[i] ) ), xm1 );
+		const __m128 bD = _mm_mul_ps( _mm_sub_ps( _mm_mul_ps( _mm_set1_ps( u[i] ), sqrD ), _mm_set1_ps( v[i] ) ), xm1 );
+		seriesT = _mm_add_ps( one, _mm_mul_ps( bT, seriesT ) );
+		seriesD = _mm_add_ps( one, _mm_mul_ps( bD, seriesD ) );
+	}
+
+	const __m128 lerp = _mm_xor_ps( _mm_mul_ps( t, seriesT ), sign );
+	const __m128 backLerp = _mm_mul_ps( d, seriesD );
+
+	out.rx = _mm_add_ps( _mm_mul_ps( from.rx, backLerp ), _mm_mul_ps( to.rx, lerp ) );
+	out.ry = _mm_add_ps( _mm_mul_ps( from.ry, backLerp ), _mm_mul_ps( to.ry, lerp ) );
+	out.rz = _mm_add_ps( _mm_mul_ps( from.rz, backLerp ), _mm_mul_ps( to.rz, lerp ) );
+	out.rw = _mm_add_ps( _mm_mul_ps( from.rw, backLerp ), _mm_mul_ps( to.rw, lerp ) );
+}
+
+/**
+*	@brief	Lerps translation and scale, and slerps the rotation of 4 bone poses.
+**/
+static inline void ES_LerpBonePosesSoA( const EntitySkeletonBonePoseSoA &from, const EntitySkeletonBonePoseSoA &to, const float fraction, EntitySkeletonBonePoseSoA &out ) {
+	const __m128 lerp = _mm_set1_ps( fraction );
+	const __m128 backLerp = _mm_set1_ps( 1.f - fraction );
+
+	out.tx = _mm_add_ps( _mm_mul_ps( from.tx, backLerp ), _mm_mul_ps( to.tx, lerp ) );
+	out.ty = _mm_add_ps( _mm_mul_ps( from.ty, backLerp ), _mm_mul_ps( to.ty, lerp ) );
+	out.tz = _mm_add_ps( _mm_mul_ps( from.tz, backLerp ), _mm_mul_ps( to.tz, lerp ) );
+	out.sx = _mm_add_ps( _mm_mul_ps( from.sx, backLerp ), _mm_mul_ps( to.sx, lerp ) );
+	out.sy = _mm_add_ps( _mm_mul_ps( from.sy, backLerp ), _mm_mul_ps( to.sy, lerp ) );
+	out.sz = _mm_add_ps( _mm_mul_ps( from.sz, backLerp ), _mm_mul_ps( to.sz, lerp ) );
+
+	ES_SlerpRotationsSoA( from, to, fraction, out );
+}
+
+/**
+*	@brief	JointToMatrix for 4 bone poses, writes each 3x4 matrix to mats[i * 12].
+**/
+static inline void ES_JointToMatricesSoA( const EntitySkeletonBonePoseSoA &in, float *mats ) {
+	const __m128 one = _mm_set1_ps( 1.f );
+	const __m128 two = _mm_set1_ps( 2.f );
+
+	const __m128 x2 = _mm_mul_ps( two, in.rx );
+	const __m128 y2 = _mm_mul_ps( two, in.ry );
+	const __m128 z2 = _mm_mul_ps( two, in.rz );
+	const __m128 xx = _mm_mul_ps( x2, in.rx );
+	const __m128 yy = _mm_mul_ps( y2, in.ry );
+	const __m128 zz = _mm_mul_ps( z2, in.rz );
+	const __m128 xy = _mm_mul_ps( x2, in.ry );
+	const __m128 xz = _mm_mul_ps( x2, in.rz );
+	const __m128 yz = _mm_mul_ps( y2, in.rz );
+	const __m128 wx = _mm_mul_ps( x2, in.rw );
+	const __m128 wy = _mm_mul_ps( y2, in.rw );
+	const __m128 wz = _mm_mul_ps( z2, in.rw );
+
+	// Rows of the 4 matrices, one matrix per lane.
+	__m128 m[12] = {
+		_mm_mul_ps( in.sx, _mm_sub_ps( one, _mm_add_ps( yy, zz ) ) ),
+		_mm_mul_ps( in.sx, _mm_sub_ps( xy, wz ) ),
+		_mm_mul_ps( in.sx, _mm_add_ps( xz, wy ) ),
+		in.tx,
+		_mm_mul_ps( in.sy, _mm_add_ps( xy, wz ) ),
+		_mm_mul_ps( in.sy, _mm_sub_ps( one, _mm_add_ps( xx, zz ) ) ),
+		_mm_mul_ps( in.sy, _mm_sub_ps( yz, wx ) ),
+		in.ty,
+		_mm_mul_ps( in.sz, _mm_sub_ps( xz, wy ) ),
+		_mm_mul_ps( in.sz, _mm_add_ps( yz, wx ) ),
+		_mm_mul_ps( in.sz, _mm_sub_ps( one, _mm_add_ps( xx, yy ) ) ),
+		in.tz,
+	};
+
+	// Transpose each row of 4 lanes back into the 4 matrices.
+	for ( int32_t row = 0; row < 12; row += 4 ) {
+		_MM_TRANSPOSE4_PS( m[row + 0], m[row + 1], m[row + 2], m[row + 3] );
+		_mm_storeu_ps( mats + 0 * 12 + row, m[row + 0] );
+		_mm_storeu_ps( mats + 1 * 12 + row, m[row + 1] );
+		_mm_storeu_ps( mats + 2 * 12 + row, m[row + 2] );
+		_mm_storeu_ps( mats + 3 * 12 + row, m[row + 3] );
+	}
+}
+
+/**
+*	@brief	SSE version of Matrix34Multiply, out may alias a or b.
+**/
+static inline void Matrix34Multiply_SSE( const float *a, const float *b, float *out ) {
+	const __m128 b0 = _mm_loadu_ps( b + 0 );
+	const __m128 b1 = _mm_loadu_ps( b + 4 );
+	const __m128 b2 = _mm_loadu_ps( b + 8 );
+
+	__m128 rows[3];
+	for ( int32_t i = 0; i < 3; i++ ) {
+		const float *ra = a + i * 4;
+		rows[i] = _mm_add_ps( _mm_add_ps( _mm_mul_ps( _mm_set1_ps( ra[0] ), b0 ), _mm_mul_ps( _mm_set1_ps( ra[1] ), b1 ) ),
+							  _mm_add_ps( _mm_mul_ps( _mm_set1_ps( ra[2] ), b2 ), _mm_setr_ps( 0.f, 0.f, 0.f, ra[3] ) ) );
+	}
+
+	_mm_storeu_ps( out + 0, rows[0] );
+	_mm_storeu_ps( out + 4, rows[1] );
+	_mm_storeu_ps( out + 8, rows[2] );
+}
+#endif // ES_USE_SSE2
+
+/**
+*	@brief	Multiplies using the SSE version where it is available.
+**/
+static inline void Matrix34Multiply( const float *a, const float *b, float *out ) {
+#if ES_USE_SSE2
+	Matrix34Multiply_SSE( a, b, out );
+#else
+	Matrix34Multiply_C( a, b, out );
+#endif
+}
+
+/**
+*	@brief	Identity index table for running the SoA kernels on consecutive bones.
+**/
+static const int32_t *ES_SequentialBoneIndices( int32_t first ) {
+	// Initialized on first use, which is thread safe for function local statics.
+	static const std::array<int32_t, IQM_MAX_JOINTS + 4> indices = [] {
+		std::array<int32_t, IQM_MAX_JOINTS + 4> sequence;
+		for ( int32_t i = 0; i < IQM_MAX_JOINTS + 4; i++ ) {
+			sequence[i] = i;
+		}
+		return sequence;
+	}();
+
+	return &indices[first];
+}
+
+/**
+*	@brief	Lerps, and slerps the bone poses at (boneIndices) from 'from' to 'to' at fraction into 'out'.
+**/
+static void ES_LerpBonePoses( const EntitySkeletonBonePose *from, const EntitySkeletonBonePose *to, EntitySkeletonBonePose *out, const int32_t *boneIndices, uint32_t numBoneIndices, float fraction ) {
+	uint32_t i = 0;
+
+#if ES_USE_SSE2
+	for ( ; i + 4 <= numBoneIndices; i += 4 ) {
+		const int32_t *indices = &boneIndices[i];
+		EntitySkeletonBonePoseSoA soaFrom, soaTo, soaOut;
+
+		ES_LoadBonePosesSoA( from, indices, soaFrom );
+		ES_LoadBonePosesSoA( to, indices, soaTo );
+		ES_LerpBonePosesSoA( soaFrom, soaTo, fraction, soaOut );
+		ES_StoreBonePosesSoA( soaOut, out, indices );
+	}
+#endif
+
+	const float backLerp = 1.0f - fraction;
+	for ( ; i < numBoneIndices; i++ ) {
+		const int32_t poseIndex = boneIndices[i];
+		const EntitySkeletonBonePose *oldpose = from + poseIndex;
+		const EntitySkeletonBonePose *pose = to + poseIndex;
+		EntitySkeletonBonePose *relativeBonePose = out + poseIndex;
+
+		// Calculate translation.
+		relativeBonePose->translate[0] = oldpose->translate[0] * backLerp + pose->translate[0] * fraction;
+		relativeBonePose->translate[1] = oldpose->translate[1] * backLerp + pose->translate[1] * fraction;
+		relativeBonePose->translate[2] = oldpose->translate[2] * backLerp + pose->translate[2] * fraction;
+
+		// Scale.
+		relativeBonePose->scale[0] = oldpose->scale[0] * backLerp + pose->scale[0] * fraction;
+		relativeBonePose->scale[1] = oldpose->scale[1] * backLerp + pose->scale[1] * fraction;
+		relativeBonePose->scale[2] = oldpose->scale[2] * backLerp + pose->scale[2] * fraction;
+
+		// Slerp rotation.
+		QuatSlerp( oldpose->rotate, pose->rotate, fraction, relativeBonePose->rotate );
+	}
+}
+
+
+
 /**
 *	@brief	Expects the boneTree's head node to already be set pointing at the
 *			root bone.
@@ -311,11 +580,31 @@ void ES_StandardComputeTransforms( const model_t* model, const r_entity_t* entit
 	// Lerp skeleton poses.
 	ES_LerpSkeletonPoses( &tempEs, temporaryBonePoses, entity->frame, entity->oldframe, entity->backlerp, entity->rootBoneAxisFlags );
 
-	// Compute world, and local bone transforms.
-	ES_ComputeWorldPoseTransforms( model, temporaryBonePoses, pose_matrices );
+	// Compute local bone transforms.
 	ES_ComputeLocalPoseTransforms( model, temporaryBonePoses, pose_matrices );
 }
 
+/**
+*	@brief	Zeroes out the root bone's translation for each axis that has its Zero*Translation flag set.
+**/
+static void ES_ApplyRootBoneAxisFlags( const iqm_model_t *iqmModel, const SkeletalModelData *skmData, EntitySkeletonBonePose *bonePoses, const int32_t rootBoneAxisFlags ) {
+	if ( skmData->rootJointIndex < 0 || (uint32_t)skmData->rootJointIndex >= iqmModel->num_poses ) {
+		return;
+	}
+
+	EntitySkeletonBonePose *rootBonePose = bonePoses + skmData->rootJointIndex;
+
+	if ( (rootBoneAxisFlags & SkeletalAnimationAction::RootBoneAxisFlags::ZeroXTranslation) ) {
+		rootBonePose->translate.x = 0.0;
+	}
+	if ( (rootBoneAxisFlags & SkeletalAnimationAction::RootBoneAxisFlags::ZeroYTranslation) ) {
+		rootBonePose->translate.y = 0.0;
+	}
+	if ( (rootBoneAxisFlags & SkeletalAnimationAction::RootBoneAxisFlags::ZeroZTranslation) ) {
+		rootBonePose->translate.z = 0.0;
+	}
+}
+
 /**
 *	@brief	Computes the LERP Pose result for in-between the old and current frame by calculating each 
 *			relative transform for all bones.
@@ -400,96 +689,78 @@ void ES_LerpSkeletonPoses( EntitySkeleton *entitySkeleton, EntitySkeletonBonePos
 // DQ: ------------------- END
 
 	// Copy or lerp animation currentFrame pose
+	const EntitySkeletonBonePose* pose = &iqmModel->poses[currentFrame * iqmModel->num_poses];
+	const EntitySkeletonBonePose* oldpose = &iqmModel->poses[oldFrame * iqmModel->num_poses];
 	if (oldFrame == currentFrame) {
-		const EntitySkeletonBonePose* pose = &iqmModel->poses[currentFrame * iqmModel->num_poses];
-		for (uint32_t poseIndex = 0; poseIndex < iqmModel->num_poses; poseIndex++, pose++, relativeBonePose++) {
-			// Do we have skeletal model data?
-			if (skmData && poseIndex == skmData->rootJointIndex) {
-				// Copy over the pose's translation.
-				relativeBonePose->translate = pose->translate;
-
-				// See whether to cancel/zero out any axis.
-				if ( (rootBoneAxisFlags & SkeletalAnimationAction::RootBoneAxisFlags::ZeroXTranslation) ) {
-					relativeBonePose->translate.x = 0.0;
-				}
-				if ( (rootBoneAxisFlags & SkeletalAnimationAction::RootBoneAxisFlags::ZeroYTranslation) ) {
-					relativeBonePose->translate.y = 0.0;
-				}
-				if ( (rootBoneAxisFlags & SkeletalAnimationAction::RootBoneAxisFlags::ZeroZTranslation) ) {
-					relativeBonePose->translate.z = 0.0;
-				}
-
-				// Copy over the pose's scale.
-				relativeBonePose->scale = pose->scale;
-				// Copy over the pose's rotation.
-				QuatCopy( pose->rotate, relativeBonePose->rotate );
-				
-				// Skip regular treatment.
-				continue;
-			}
-
-			// Copy over the pose's translation.
-			relativeBonePose->translate = pose->translate;
-			// Copy over the pose's scale.
-			relativeBonePose->scale = pose->scale;
-			// Copy over the pose's rotation.
-			QuatCopy( pose->rotate, relativeBonePose->rotate );
+		memcpy( relativeBonePose, pose, sizeof( EntitySkeletonBonePose ) * iqmModel->num_poses );
+	} else {
+		ES_LerpBonePoses( oldpose, pose, relativeBonePose, ES_SequentialBoneIndices( 0 ), iqmModel->num_poses, lerp );
+	}
 
-			continue;
-		}
+	// Cancel out the root bone's translation for each axis that has its Zero*Translation flag set.
+	ES_ApplyRootBoneAxisFlags( iqmModel, skmData, outBonePose, rootBoneAxisFlags );
+}
 
-	} else {
-		const EntitySkeletonBonePose* pose = &iqmModel->poses[currentFrame * iqmModel->num_poses];
-		const EntitySkeletonBonePose* oldpose = &iqmModel->poses[oldFrame * iqmModel->num_poses];
-		for (uint32_t poseIndex = 0; poseIndex < iqmModel->num_poses; poseIndex++, oldpose++, pose++, relativeBonePose++)
-		{
-			// Do we have skeletal model data?
-			if (skmData && poseIndex == skmData->rootJointIndex) {
-				
-				// Cancel out if the Zero*Translation flag is set, otherwise, calculate translation for that axis.
-				if ( (rootBoneAxisFlags & SkeletalAnimationAction::RootBoneAxisFlags::ZeroXTranslation) ) {
-					relativeBonePose->translate.x = 0.0;
-				} else {
-					relativeBonePose->translate.x = oldpose->translate.x * backLerp + pose->translate.x * lerp;
-				}
-				if ( (rootBoneAxisFlags & SkeletalAnimationAction::RootBoneAxisFlags::ZeroYTranslation) ) {
-					relativeBonePose->translate.y = 0.0;
-				} else {
-					relativeBonePose->translate.y = oldpose->translate.y * backLerp + pose->translate.y * lerp;
-				}
-				if ( (rootBoneAxisFlags & SkeletalAnimationAction::RootBoneAxisFlags::ZeroZTranslation) ) {
-					relativeBonePose->translate.z = 0.0;
-				} else {
-					relativeBonePose->translate.z = oldpose->translate.z * backLerp + pose->translate.z * lerp;
-				}
-				
-				// Calculate the Joint's pose scale.				
-				relativeBonePose->scale[0] = oldpose->scale[0] * backLerp + pose->scale[0] * lerp;
-				relativeBonePose->scale[1] = oldpose->scale[1] * backLerp + pose->scale[1] * lerp;
-				relativeBonePose->scale[2] = oldpose->scale[2] * backLerp + pose->scale[2] * lerp;
-
-				// Copy over the pose's rotation.
-				//QuatCopy(pose->rotate, relativeBone->rotate);
-				// Slerp rotation.
-				QuatSlerp( oldpose->rotate, pose->rotate, lerp, relativeBonePose->rotate );
-
-				// Skip regular treatment.
-				continue;
-			}
-
-			// Calculate translation.
-			relativeBonePose->translate[0] = oldpose->translate[0] * backLerp + pose->translate[0] * lerp;
-			relativeBonePose->translate[1] = oldpose->translate[1] * backLerp + pose->translate[1] * lerp;
-			relativeBonePose->translate[2] = oldpose->translate[2] * backLerp + pose->translate[2] * lerp;
-
-			// Scale.
-			relativeBonePose->scale[0] = oldpose->scale[0] * backLerp + pose->scale[0] * lerp;
-			relativeBonePose->scale[1] = oldpose->scale[1] * backLerp + pose->scale[1] * lerp;
-			relativeBonePose->scale[2] = oldpose->scale[2] * backLerp + pose->scale[2] * lerp;
-
-			// Slerp rotation.
-			QuatSlerp( oldpose->rotate, pose->rotate, lerp, relativeBonePose->rotate );
-		}
+/**
+*	@brief	Same as ES_LerpSkeletonPoses, but only lerps the bones in boneIndices. All other bones
+*			are copied from the current frame as is.
+**/
+void ES_LerpSkeletonPosesForBones( EntitySkeleton *entitySkeleton, EntitySkeletonBonePose *outBonePose, const int32_t *boneIndices, const uint32_t numBoneIndices, int32_t currentFrame, int32_t oldFrame, float backLerp, const int32_t rootBoneAxisFlags ) {
+	// Get model pointer.
+	const model_t *model = entitySkeleton->modelPtr;
+
+	if ( !model ) {
+		// TODO: Warn.
+		return;
+	}
+
+	// Get pointers to needed model data.
+	const iqm_model_t *iqmModel = model->iqmData;
+	const SkeletalModelData *skmData = model->skeletalModelData;
+
+	// Sanity Checks:
+	if ( !iqmModel )	{ /* Todo: Warn */ return; }
+	if ( !skmData )		{ /* Todo: Warn */ return; }
+	if ( !outBonePose ) { /* Todo: Warn */ return; }
+
+	if ( currentFrame > iqmModel->num_frames || currentFrame < 0 ) {
+		currentFrame = 0;
+	}
+	if ( oldFrame > iqmModel->num_frames || oldFrame < 0 ) {
+		oldFrame = 0;
+	}
+
+	// Start off with the current frame pose.
+	const EntitySkeletonBonePose* pose = &iqmModel->poses[currentFrame * iqmModel->num_poses];
+	const EntitySkeletonBonePose* oldpose = &iqmModel->poses[oldFrame * iqmModel->num_poses];
+	memcpy( outBonePose, pose, sizeof( EntitySkeletonBonePose ) * iqmModel->num_poses );
+
+	// Lerp only the requested bones.
+	if ( oldFrame != currentFrame && boneIndices && numBoneIndices ) {
+		ES_LerpBonePoses( oldpose, pose, outBonePose, boneIndices, numBoneIndices, 1.0f - backLerp );
+	}
+
+	// Cancel out the root bone's translation for each axis that has its Zero*Translation flag set.
+	ES_ApplyRootBoneAxisFlags( iqmModel, skmData, outBonePose, rootBoneAxisFlags );
+}
+
+/**
+*	@brief	Gathers the bone indices of boneNode and its children, skipping the subtrees of invalid bones.
+**/
+static void ES_GatherBlendBoneIndices( EntitySkeletonBoneNode *boneNode, int32_t *boneIndices, uint32_t &numBoneIndices ) {
+	// Get the bone.
+	const EntitySkeletonBone *esBone = boneNode->GetEntitySkeletonBone();
+
+	// Skip invalid bones, and their children.
+	if ( !esBone || esBone->index < 0 || numBoneIndices >= IQM_MAX_JOINTS ) {
+		return;
+	}
+
+	boneIndices[numBoneIndices++] = esBone->index;
+
+	// Recursively gather all this bone node's children.
+	for ( auto &childBoneNode : boneNode->GetChildren() ) {
+		ES_GatherBlendBoneIndices( &childBoneNode, boneIndices, numBoneIndices );
 	}
 }
 
@@ -507,79 +778,61 @@ void ES_RecursiveBlendFromBone( EntitySkeletonBonePose *addBonePoses, EntitySkel
 		return;
 	}
 
-	// Get the bone.
-	const EntitySkeletonBone *esBone = boneNode->GetEntitySkeletonBone();
-	
-	// If the bone is invalid, escape.
-	if ( !esBone ) {
-		// TODO: Warn.
-		return;
-	}
-	
-	// Get bone number.
-	const int32_t boneNumber = esBone->index;
-
-	if (esBone->index >= 0) {
-		EntitySkeletonBonePose *inBone = addBonePoses + boneNumber;
-		EntitySkeletonBonePose *outBone = addToBonePoses + boneNumber;
+	// Flatten the bone node's subtree into a list of bone indices first so the
+	// blend itself can run over 4 bones at a time.
+	int32_t boneIndices[IQM_MAX_JOINTS];
+	uint32_t numBoneIndices = 0;
+	ES_GatherBlendBoneIndices( boneNode, boneIndices, numBoneIndices );
 
 // DQ: ------------------- START
-		//if (fraction == 1) {
-		//	*outBone = *inBone;
-		//} else {
-		//	dualquat_lerp( inBone->dualquat, outBone->dualquat, fraction, outBone->dualquat );
-		//}
-// DQ: ------------------- END
-		if (fraction == 1) {
-			*outBone = *inBone;
-		} else {
-			//
-			//	WID: Unsure if actually lerping these is favored.
-			//
-			const float lerp = 1.0f - backlerp;
-			// Lerp the already Lerped Translation.
-			//outBone->translate[0] = outBone->translate[0] * backlerp + inBone->translate[0] * lerp;
-			//outBone->translate[1] = outBone->translate[1] * backlerp + inBone->translate[1] * lerp;
-			//outBone->translate[2] = outBone->translate[2] * backlerp + inBone->translate[2] * lerp;
-
-			// Lerp the already Lerped Scale.
-			//outBone->scale[0] = outBone->scale[0] * backlerp + inBone->scale[0] * lerp;
-			//outBone->scale[1] = outBone->scale[1] * backlerp + inBone->scale[1] * lerp;
-			//outBone->scale[2] = outBone->scale[2] * backlerp + inBone->scale[2] * lerp;
-			
-	//if( bonenode->bonenum != -1 ) {
-	//	inbone = inboneposes + bonenode->bonenum;
-	//	outbone = outboneposes + bonenode->bonenum;
-	//	if( frac == 1 ) {
-	//		memcpy( &outboneposes[bonenode->bonenum], &inboneposes[bonenode->bonenum], sizeof( bonepose_t ) );
-	//	} else {
-	//		// blend current node pose
-	//		DualQuat_Lerp( inbone->dualquat, outbone->dualquat, frac, outbone->dualquat );
-	//	}
+	//if (fraction == 1) {
+	//	*outBone = *inBone;
+	//} else {
+	//	dualquat_lerp( inBone->dualquat, outBone->dualquat, fraction, outBone->dualquat );
 	//}
+// DQ: ------------------- END
+	if (fraction == 1) {
+		for ( uint32_t i = 0; i < numBoneIndices; i++ ) {
+			addToBonePoses[boneIndices[i]] = addBonePoses[boneIndices[i]];
+		}
+		return;
+	}
 
-	//for( i = 0; i < bonenode->numbonechildren; i++ ) {
-	//	if( bonenode->bonechildren[i] ) {
-	//		CG_RecurseBlendSkeletalBone( inboneposes, outboneposes, bonenode->bonechildren[i], frac );
-	//	}
-	//}
+	//
+	//	WID: Unsure if actually lerping the translation and scale is favored, for now
+	//	they are copied over and only the rotation is slerped at fraction.
+	//
+	uint32_t i = 0;
+#if ES_USE_SSE2
+	for ( ; i + 4 <= numBoneIndices; i += 4 ) {
+		EntitySkeletonBonePoseSoA inBones, outBones;
 
-			// Copy Translation.
-			outBone->translate = inBone->translate;
+		ES_LoadBonePosesSoA( addBonePoses, &boneIndices[i], inBones );
+		ES_LoadBonePosesSoA( addToBonePoses, &boneIndices[i], outBones );
 
-			// Copy Scale.
-			outBone->scale = inBone->scale; //vec3_scale(inBone->scale, 1.175);
+		// Slerp the rotation at fraction.
+		ES_SlerpRotationsSoA( outBones, inBones, fraction, outBones );
 
-			// Slerp the rotation at fraction.	
-			QuatSlerp(outBone->rotate, inBone->rotate, fraction, outBone->rotate);
-		}
-			
-		// Recursively blend all thise bone node's children.
-		for ( auto &childBoneNode : boneNode->GetChildren() ) {
-			ES_RecursiveBlendFromBone( addBonePoses, addToBonePoses, &childBoneNode, backlerp, fraction );
-		}
+		// Copy Translation, and Scale.
+		outBones.tx = inBones.tx; outBones.ty = inBones.ty; outBones.tz = inBones.tz;
+		outBones.sx = inBones.sx; outBones.sy = inBones.sy; outBones.sz = inBones.sz;
+
+		ES_StoreBonePosesSoA( outBones, addToBonePoses, &boneIndices[i] );
 	}
+#endif
+	for ( ; i < numBoneIndices; i++ ) {
+		EntitySkeletonBonePose *inBone = addBonePoses + boneIndices[i];
+		EntitySkeletonBonePose *outBone = addToBonePoses + boneIndices[i];
+
+		// Copy Translation.
+		outBone->translate = inBone->translate;
+
+		// Copy Scale.
+		outBone->scale = inBone->scale;
 
+		// Slerp the rotation at fraction.	
+		QuatSlerp(outBone->rotate, inBone->rotate, fraction, outBone->rotate);
+	}
 }
 
 /**
@@ -704,15 +957,29 @@ void ES_ComputeLocalPoseTransforms( const model_t *model, const EntitySkeletonBo
 	// Get IQM Data.
 	const iqm_model_t *iqmModel = model->iqmData;
 	
+	// Convert all joints to matrices first, using poseMatrices as scratch space. Joint parents
+	// always precede their children, so each parent is final by the time a child reads it.
+	uint32_t poseIndex = 0;
+#if ES_USE_SSE2
+	for ( ; poseIndex + 4 <= iqmModel->num_poses; poseIndex += 4 ) {
+		EntitySkeletonBonePoseSoA joints;
+		ES_LoadBonePosesSoA( bonePoses, ES_SequentialBoneIndices( poseIndex ), joints );
+		ES_JointToMatricesSoA( joints, &poseMatrices[poseIndex * 12] );
+	}
+#endif
+	for ( ; poseIndex < iqmModel->num_poses; poseIndex++ ) {
+		const EntitySkeletonBonePose *relativeJoint = &bonePoses[poseIndex];
+		JointToMatrix(relativeJoint->rotate, relativeJoint->scale, relativeJoint->translate, &poseMatrices[poseIndex * 12]);
+	}
+
 	// multiply by inverse of bind pose and parent 'pose mat' (bind pose transform matrix)
-	const EntitySkeletonBonePose *relativeJoint = bonePoses;
 	const int* jointParent = iqmModel->jointParents;
 	const float* invBindMat = iqmModel->invBindJoints;
 	float* poseMat = poseMatrices;
-	for (uint32_t pose_idx = 0; pose_idx < iqmModel->num_poses; pose_idx++, relativeJoint++, jointParent++, invBindMat += 12, poseMat += 12) {
+	for (uint32_t pose_idx = 0; pose_idx < iqmModel->num_poses; pose_idx++, jointParent++, invBindMat += 12, poseMat += 12) {
 		float mat1[12], mat2[12];
 
-		JointToMatrix(relativeJoint->rotate, relativeJoint->scale, relativeJoint->translate, mat1);
+		memcpy(mat1, poseMat, sizeof(mat1));
 
 		if (*jointParent >= 0) {
 			Matrix34Multiply(&iqmModel->bindJoints[(*jointParent) * 12], mat1, mat2);
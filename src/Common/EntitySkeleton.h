@@ -24,6 +24,11 @@ const bool ES_CreateFromModel( const model_t *model, EntitySkeleton *es );
 *			
 **/
 void ES_LerpSkeletonPoses( EntitySkeleton *entitySkeleton, EntitySkeletonBonePose *outBonePose, int32_t currentFrame, int32_t oldFrame, float backLerp, const int32_t rootBoneAxisFlags );
+/**
+*	@brief	Same as ES_LerpSkeletonPoses, but only lerps the bones in boneIndices. All other bones
+*			are copied from the current frame as is. Used for animation LOD.
+**/
+void ES_LerpSkeletonPosesForBones( EntitySkeleton *entitySkeleton, EntitySkeletonBonePose *outBonePose, const int32_t *boneIndices, const uint32_t numBoneIndices, int32_t currentFrame, int32_t oldFrame, float backLerp, const int32_t rootBoneAxisFlags );
 
 /**
 *	@brief	Combine 2 poses into one by performing a recursive blend starting from the given boneNode, using the given fraction as "intensity".
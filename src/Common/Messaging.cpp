@@ -145,6 +145,7 @@ const char* MSG_ServerCommandString(int cmd)
             S(ZPacket)
             S(ZDownload)
             S(GameState)
+            S(PlayerStates)
 #undef S
     }
 }
@@ -0,0 +1,203 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Delta Entity State Fields: The field table shared by the delta entity state writer,
+*	and parser.
+*
+***/
+#include "Shared/Shared.h"
+#include "../HalfFloat.h"
+#include "../Messaging.h"
+#include "../Protocol.h"
+#include "../SizeBuffer.h"
+
+// TODO: Make this not needed, let the Game Modules supply an API for these needs.
+#include "Game/Shared/Protocol.h"
+
+#include "DeltaEntityStateFields.h"
+
+// For std::countr_zero.
+#include <bit>
+// For offsetof.
+#include <cstddef>
+
+
+
+//! Offset of a float within a vec3_t member.
+#define ES_VEC3_OFFSET( member, index ) ( offsetof( EntityState, member ) + sizeof( float ) * ( index ) )
+
+//! The delta entity state fields, in the order they are sent over the wire.
+static constexpr DeltaEntityStateField deltaEntityStateFields[] = {
+	{ EntityMessageBits::ModelIndex,			DeltaEntityStateFieldType::Uint8,			offsetof( EntityState, modelIndex ) },
+	{ EntityMessageBits::ModelIndex2,			DeltaEntityStateFieldType::Uint8,			offsetof( EntityState, modelIndex2 ) },
+	{ EntityMessageBits::ModelIndex3,			DeltaEntityStateFieldType::Uint8,			offsetof( EntityState, modelIndex3 ) },
+	{ EntityMessageBits::ModelIndex4,			DeltaEntityStateFieldType::Uint8,			offsetof( EntityState, modelIndex4 ) },
+	{ EntityMessageBits::AnimationFrame,		DeltaEntityStateFieldType::HalfFloat,		offsetof( EntityState, animationFrame ) },
+	{ EntityMessageBits::Skin,					DeltaEntityStateFieldType::Int16,			offsetof( EntityState, skinNumber ) },
+	{ EntityMessageBits::EntityEffects,			DeltaEntityStateFieldType::UintBase128,		offsetof( EntityState, effects ) },
+	{ EntityMessageBits::RenderEffects,			DeltaEntityStateFieldType::IntBase128,		offsetof( EntityState, renderEffects ) },
+	{ EntityMessageBits::HashedClassname,		DeltaEntityStateFieldType::Uint32,			offsetof( EntityState, hashedClassname ) },
+	{ EntityMessageBits::OriginX,				DeltaEntityStateFieldType::Float,			ES_VEC3_OFFSET( origin, 0 ) },
+	{ EntityMessageBits::OriginY,				DeltaEntityStateFieldType::Float,			ES_VEC3_OFFSET( origin, 1 ) },
+	{ EntityMessageBits::OriginZ,				DeltaEntityStateFieldType::Float,			ES_VEC3_OFFSET( origin, 2 ) },
+	{ EntityMessageBits::AngleX,				DeltaEntityStateFieldType::HalfFloat,		ES_VEC3_OFFSET( angles, 0 ) },
+	{ EntityMessageBits::AngleY,				DeltaEntityStateFieldType::HalfFloat,		ES_VEC3_OFFSET( angles, 1 ) },
+	{ EntityMessageBits::AngleZ,				DeltaEntityStateFieldType::HalfFloat,		ES_VEC3_OFFSET( angles, 2 ) },
+	{ EntityMessageBits::OldOrigin,				DeltaEntityStateFieldType::Vector3,			offsetof( EntityState, oldOrigin ) },
+	{ EntityMessageBits::Sound,					DeltaEntityStateFieldType::Uint8,			offsetof( EntityState, sound ) },
+	{ EntityMessageBits::EventID,				DeltaEntityStateFieldType::Uint8,			offsetof( EntityState, eventID ) },
+	{ EntityMessageBits::Solid,					DeltaEntityStateFieldType::Int32,			offsetof( EntityState, solid ) },
+	{ EntityMessageBits::Bounds,				DeltaEntityStateFieldType::BoundingBox,		0 },
+	{ EntityMessageBits::AnimationTimeStart,	DeltaEntityStateFieldType::Uint64Base128,	offsetof( EntityState, currentAnimation ) + offsetof( EntityAnimationState, startTime ) },
+	{ EntityMessageBits::AnimationIndex,		DeltaEntityStateFieldType::Uint8,			offsetof( EntityState, currentAnimation ) + offsetof( EntityAnimationState, animationIndex ) },
+};
+#undef ES_VEC3_OFFSET
+
+//! Number of fields.
+static constexpr int32_t numberOfDeltaEntityStateFields = (int32_t)std::size( deltaEntityStateFields );
+static_assert( numberOfDeltaEntityStateFields <= 32, "Field order mask has to fit in 32 bits" );
+
+/**
+*	@brief	For each of the 4 bytes of a byteMask, and each of its 256 values, the mask of table
+*			indices (The field order mask) of the fields that these bits send.
+*
+*			Iterating the set bits of a field order mask visits only the fields that are sent,
+*			in wire order.
+**/
+struct DeltaEntityStateFieldOrderTable {
+	uint32_t masks[4][256] = {};
+
+	constexpr DeltaEntityStateFieldOrderTable() {
+		for ( int32_t byteIndex = 0; byteIndex < 4; byteIndex++ ) {
+			for ( int32_t value = 0; value < 256; value++ ) {
+				const uint32_t bits = (uint32_t)value << ( byteIndex * 8 );
+
+				for ( int32_t fieldIndex = 0; fieldIndex < numberOfDeltaEntityStateFields; fieldIndex++ ) {
+					if ( bits & deltaEntityStateFields[ fieldIndex ].bit ) {
+						masks[ byteIndex ][ value ] |= ( 1U << fieldIndex );
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	*	@return	The field order mask for byteMask.
+	**/
+	inline const uint32_t GetFieldOrderMask( const uint32_t byteMask ) const {
+		return masks[0][ byteMask & 255 ] | masks[1][ ( byteMask >> 8 ) & 255 ] | masks[2][ ( byteMask >> 16 ) & 255 ] | masks[3][ byteMask >> 24 ];
+	}
+};
+static constexpr DeltaEntityStateFieldOrderTable deltaEntityStateFieldOrderTable;
+
+
+/**
+*	@brief	Writes the fields of 'to' whose bits are set in byteMask, in wire order.
+**/
+void MSG_WriteDeltaEntityStateFields( const EntityState *to, uint32_t byteMask ) {
+	const byte *state = reinterpret_cast<const byte*>( to );
+
+	for ( uint32_t fieldOrderMask = deltaEntityStateFieldOrderTable.GetFieldOrderMask( byteMask ); fieldOrderMask; fieldOrderMask &= fieldOrderMask - 1 ) {
+		const DeltaEntityStateField &field = deltaEntityStateFields[ std::countr_zero( fieldOrderMask ) ];
+		const byte *value = state + field.offset;
+
+		switch ( field.type ) {
+		case DeltaEntityStateFieldType::Uint8:
+			MSG_WriteUint8( *reinterpret_cast<const int32_t*>( value ) );
+			break;
+		case DeltaEntityStateFieldType::Int16:
+			MSG_WriteInt16( *reinterpret_cast<const int32_t*>( value ) );
+			break;
+		case DeltaEntityStateFieldType::Int32:
+			MSG_WriteInt32( *reinterpret_cast<const int32_t*>( value ) );
+			break;
+		case DeltaEntityStateFieldType::Uint32:
+			MSG_WriteUint32( *reinterpret_cast<const uint32_t*>( value ) );
+			break;
+		case DeltaEntityStateFieldType::UintBase128:
+			MSG_WriteUintBase128( *reinterpret_cast<const uint32_t*>( value ) );
+			break;
+		case DeltaEntityStateFieldType::Uint64Base128:
+			MSG_WriteUintBase128( *reinterpret_cast<const uint64_t*>( value ) );
+			break;
+		case DeltaEntityStateFieldType::IntBase128:
+			MSG_WriteIntBase128( *reinterpret_cast<const int32_t*>( value ) );
+			break;
+		case DeltaEntityStateFieldType::HalfFloat:
+			MSG_WriteHalfFloat( *reinterpret_cast<const float*>( value ) );
+			break;
+		case DeltaEntityStateFieldType::Float:
+			MSG_WriteFloat( *reinterpret_cast<const float*>( value ) );
+			break;
+		case DeltaEntityStateFieldType::Vector3:
+			MSG_WriteVector3( *reinterpret_cast<const vec3_t*>( value ) );
+			break;
+		case DeltaEntityStateFieldType::BoundingBox:
+			MSG_WriteUint8( -to->mins.x );
+			MSG_WriteUint8( -to->mins.y );
+			MSG_WriteUint8( -to->mins.z );
+
+			MSG_WriteUint8( to->maxs.x );
+			MSG_WriteUint8( to->maxs.y );
+			MSG_WriteUint8( to->maxs.z );
+			break;
+		}
+	}
+}
+
+/**
+*	@brief	Reads the fields whose bits are set in byteMask into 'to', in wire order.
+**/
+void MSG_ReadDeltaEntityStateFields( EntityState *to, uint32_t byteMask ) {
+	byte *state = reinterpret_cast<byte*>( to );
+
+	for ( uint32_t fieldOrderMask = deltaEntityStateFieldOrderTable.GetFieldOrderMask( byteMask ); fieldOrderMask; fieldOrderMask &= fieldOrderMask - 1 ) {
+		const DeltaEntityStateField &field = deltaEntityStateFields[ std::countr_zero( fieldOrderMask ) ];
+		byte *value = state + field.offset;
+
+		switch ( field.type ) {
+		case DeltaEntityStateFieldType::Uint8:
+			*reinterpret_cast<int32_t*>( value ) = MSG_ReadUint8();
+			break;
+		case DeltaEntityStateFieldType::Int16:
+			*reinterpret_cast<int32_t*>( value ) = MSG_ReadInt16();
+			break;
+		case DeltaEntityStateFieldType::Int32:
+			*reinterpret_cast<int32_t*>( value ) = MSG_ReadInt32();
+			break;
+		case DeltaEntityStateFieldType::Uint32:
+			*reinterpret_cast<uint32_t*>( value ) = MSG_ReadUint32();
+			break;
+		case DeltaEntityStateFieldType::UintBase128:
+			*reinterpret_cast<uint32_t*>( value ) = (uint32_t)MSG_ReadUintBase128();
+			break;
+		case DeltaEntityStateFieldType::Uint64Base128:
+			*reinterpret_cast<uint64_t*>( value ) = MSG_ReadUintBase128();
+			break;
+		case DeltaEntityStateFieldType::IntBase128:
+			*reinterpret_cast<int32_t*>( value ) = (int32_t)MSG_ReadIntBase128();
+			break;
+		case DeltaEntityStateFieldType::HalfFloat:
+			*reinterpret_cast<float*>( value ) = MSG_ReadHalfFloat();
+			break;
+		case DeltaEntityStateFieldType::Float:
+			*reinterpret_cast<float*>( value ) = MSG_ReadFloat();
+			break;
+		case DeltaEntityStateFieldType::Vector3:
+			*reinterpret_cast<vec3_t*>( value ) = MSG_ReadVector3();
+			break;
+		case DeltaEntityStateFieldType::BoundingBox:
+			to->mins.x = -MSG_ReadUint8();
+			to->mins.y = -MSG_ReadUint8();
+			to->mins.z = -MSG_ReadUint8();
+
+			to->maxs.x = MSG_ReadUint8();
+			to->maxs.y = MSG_ReadUint8();
+			to->maxs.z = MSG_ReadUint8();
+			break;
+		}
+	}
+}
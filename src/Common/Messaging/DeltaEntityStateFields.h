@@ -0,0 +1,64 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Delta Entity State Fields: The single description of which EntityState field is sent
+*	for each EntityMessageBits bit, how it is encoded, and in which order. Both the
+*	writer and the parser are driven by it, so the two can't drift apart.
+*
+***/
+#pragma once
+
+
+
+/**
+*	@brief	Wire encoding of a delta entity state field.
+**/
+enum class DeltaEntityStateFieldType : uint8_t {
+	//! int32_t field, sent as an unsigned byte.
+	Uint8,
+	//! int32_t field, sent as a signed short.
+	Int16,
+	//! int32_t field, sent as is.
+	Int32,
+	//! uint32_t field, sent as is.
+	Uint32,
+	//! uint32_t field, sent base 128 encoded.
+	UintBase128,
+	//! uint64_t field, sent base 128 encoded.
+	Uint64Base128,
+	//! int32_t field, sent zig-zag base 128 encoded.
+	IntBase128,
+	//! float field, sent as a half float.
+	HalfFloat,
+	//! float field, sent as is.
+	Float,
+	//! vec3_t field, sent as 3 full precision floats.
+	Vector3,
+	//! The mins/maxs bounding box, sent as 6 bytes: -mins, maxs.
+	BoundingBox,
+};
+
+/**
+*	@brief	Describes a single delta entity state field.
+**/
+struct DeltaEntityStateField {
+	//! The EntityMessageBits bit that is set when this field is sent.
+	uint32_t bit = 0;
+	//! Wire encoding.
+	DeltaEntityStateFieldType type = DeltaEntityStateFieldType::Int32;
+	//! Offset of the field within EntityState.
+	size_t offset = 0;
+};
+
+/**
+*	@brief	Writes the fields of 'to' whose bits are set in byteMask, in wire order.
+**/
+void MSG_WriteDeltaEntityStateFields(const EntityState *to, uint32_t byteMask);
+
+/**
+*	@brief	Reads the fields whose bits are set in byteMask into 'to', in wire order.
+**/
+void MSG_ReadDeltaEntityStateFields(EntityState *to, uint32_t byteMask);
@@ -16,6 +16,9 @@
 // TODO: Make this not needed, let the Game Modules supply an API for these needs.
 #include "Game/Shared/Protocol.h"
 
+// Delta Entity State Fields.
+#include "DeltaEntityStateFields.h"
+
 // Assertion.
 #include <cassert>
 
@@ -54,110 +57,6 @@ void MSG_ParseDeltaEntityState(const EntityState* from, EntityState* to, int32_t
         return;
     }
 
-    // Model Indexes.
-    if (byteMask & EntityMessageBits::ModelIndex) {
-        to->modelIndex = MSG_ReadUint8();
-    }
-    if (byteMask & EntityMessageBits::ModelIndex2) {
-        to->modelIndex2 = MSG_ReadUint8();
-    }
-    if (byteMask & EntityMessageBits::ModelIndex3) {
-        to->modelIndex3 = MSG_ReadUint8();
-    }
-    if (byteMask & EntityMessageBits::ModelIndex4) {
-        to->modelIndex4 = MSG_ReadUint8();
-    }
-
-    // Frame.
-    if (byteMask & EntityMessageBits::AnimationFrame)
-        to->animationFrame = MSG_ReadHalfFloat();
-
-    // Skinnum.
-    if (byteMask & EntityMessageBits::Skin) { 
-        to->skinNumber = MSG_ReadInt16();
-    }
-
-    // Effects.
-    if (byteMask & EntityMessageBits::EntityEffects) {
-	    to->effects = MSG_ReadUintBase128();
-    }
-
-    // RenderFX.
-    if (byteMask & EntityMessageBits::RenderEffects) {
-	    to->renderEffects = MSG_ReadIntBase128();
-    }
-
-    // HashedClassname.
-    if (byteMask & EntityMessageBits::HashedClassname) {
-	    to->hashedClassname = MSG_ReadUint32();
-    }
-
-    // Origin.
-    if (byteMask & EntityMessageBits::OriginX) {
-        to->origin[0] = MSG_ReadFloat();
-    }
-    if (byteMask & EntityMessageBits::OriginY) {
-        to->origin[1] = MSG_ReadFloat();
-    }
-    if (byteMask & EntityMessageBits::OriginZ) {
-        to->origin[2] = MSG_ReadFloat();
-    }
-
-    // Angle.
-    if (byteMask & EntityMessageBits::AngleX) {
-		to->angles[0] = MSG_ReadHalfFloat();
-    }
-    if (byteMask & EntityMessageBits::AngleY) {
-		to->angles[1] = MSG_ReadHalfFloat();
-    }
-    if (byteMask & EntityMessageBits::AngleZ) {
-		to->angles[2] = MSG_ReadHalfFloat();
-    }
-
-    // Old Origin.
-    if (byteMask & EntityMessageBits::OldOrigin) {
-        to->oldOrigin = MSG_ReadVector3();
-    }
-
-    // Sound.
-    if (byteMask & EntityMessageBits::Sound) {
-        to->sound = MSG_ReadUint8();
-    }
-
-    // Event.
-    if (byteMask & EntityMessageBits::EventID) {
-        to->eventID = MSG_ReadUint8();
-    }
-
-    // Solid.
-    if (byteMask & EntityMessageBits::Solid) {
-        to->solid = MSG_ReadInt32();
-    }
-
-    // Read in the Bounding Box.
-    if (byteMask & EntityMessageBits::Bounds) {
-
-        //MSG_WriteIntBase128(to->solid);
-		to->mins.x = -MSG_ReadUint8();
-		to->mins.y = -MSG_ReadUint8();
-		to->mins.z = -MSG_ReadUint8();
-
-		to->maxs.x = MSG_ReadUint8();
-		to->maxs.y = MSG_ReadUint8();
-		to->maxs.z = MSG_ReadUint8();
-    }
-
-    if (byteMask & EntityMessageBits::AnimationTimeStart) {
-	    to->currentAnimation.startTime = MSG_ReadUintBase128();
-    }
-    if (byteMask & EntityMessageBits::AnimationIndex) {
-	    to->currentAnimation.animationIndex = MSG_ReadUint8();
-    }
-
-    //if (byteMask & EntityMessageBits::AnimationFrameEnd) {
-	   // to->animationEndFrame = MSG_ReadUint16();
-    //}
-    //if (byteMask & EntityMessageBits::AnimationFrameTime) {
-    //	to->animationFramerate = MSG_ReadHalfFloat();
-    //}
+    // Read in the fields, see DeltaEntityStateFields.cpp for their order, and encoding.
+    MSG_ReadDeltaEntityStateFields(to, byteMask);
 }
\ No newline at end of file
@@ -16,6 +16,9 @@
 // TODO: Make this not needed, let the Game Modules supply an API for these needs.
 #include "Game/Shared/Protocol.h"
 
+// Delta Entity State Fields.
+#include "DeltaEntityStateFields.h"
+
 // Assertion.
 #include <cassert>
 
@@ -218,124 +221,6 @@ void MSG_WriteDeltaEntityState(const EntityState* from, const EntityState* to, u
     //MSG_WriteInt16(to->number);
     MSG_WriteEntityNumber(to->number, false, byteMask);
 
-    // Write out the ModelIndex.
-    if (byteMask & EntityMessageBits::ModelIndex) { 
-        MSG_WriteUint8(to->modelIndex);
-    }
-    // Write out the ModelIndex2.
-    if (byteMask & EntityMessageBits::ModelIndex2) {
-	    MSG_WriteUint8(to->modelIndex2);
-    }
-    // Write out the ModelIndex3.
-    if (byteMask & EntityMessageBits::ModelIndex3) {
-	    MSG_WriteUint8(to->modelIndex3);
-    }
-    // Write out the ModelIndex4.
-    if (byteMask & EntityMessageBits::ModelIndex4) {
-	    MSG_WriteUint8(to->modelIndex4);
-    }
-
-    // Write out the AnimationFrame.
-    if (byteMask & EntityMessageBits::AnimationFrame) {
-	    MSG_WriteHalfFloat(to->animationFrame);
-    }
-    
-    // Write out the Skin Number.
-    if (byteMask & EntityMessageBits::Skin) {
-	    MSG_WriteInt16(to->skinNumber);
-    }
-
-    // Write out the Entity Effects.
-    if (byteMask & EntityMessageBits::EntityEffects) {
-	    MSG_WriteUintBase128(to->effects);
-    }
-
-    // Write out the Render Effects.
-    if (byteMask & EntityMessageBits::RenderEffects) {
-	    MSG_WriteIntBase128(to->renderEffects);
-    }
-
-    // Write out the Render Effects.
-    if (byteMask & EntityMessageBits::HashedClassname) {
-	    MSG_WriteUint32(to->hashedClassname);
-    }
-
-    // Write out the Origin X.
-    if (byteMask & EntityMessageBits::OriginX) {
-	    MSG_WriteFloat(to->origin[0]);
-    }
-    // Write out the Origin Y.
-    if (byteMask & EntityMessageBits::OriginY) {
-	    MSG_WriteFloat(to->origin[1]);
-    }
-    // Write out the Origin Z.
-    if (byteMask & EntityMessageBits::OriginZ) {
-	    MSG_WriteFloat(to->origin[2]);
-    }
-
-    // Write out the Angle X.
-    if (byteMask & EntityMessageBits::AngleX) {
-	    //MSG_WriteFloat(to->angles.x);
-		//MSG_WriteUint16(FloatAngle2Short(to->angles[0]));
-		MSG_WriteHalfFloat(to->angles[0]);
-    }
-    // Write out the Angle Y.
-    if (byteMask & EntityMessageBits::AngleY) {
-		//MSG_WriteFloat(to->angles.y);
-		MSG_WriteHalfFloat(to->angles[1]);
-    }
-    // Write out the Angle Z.
-    if (byteMask & EntityMessageBits::AngleZ) {
-	    //MSG_WriteFloat(to->angles.z);
-		MSG_WriteHalfFloat(to->angles[2]);
-    }
-
-    // Write out the Old Origin.
-    if (byteMask & EntityMessageBits::OldOrigin) {
-        MSG_WriteVector3(to->oldOrigin);
-    }
-
-    // Write out the Sound.
-    if (byteMask & EntityMessageBits::Sound) {
-	    MSG_WriteUint8(to->sound);
-    }
-
-    // Write out the Event ID.
-    if (byteMask & EntityMessageBits::EventID) {
-	    MSG_WriteUint8(to->eventID);
-    }
-
-    // Write out the Solid.
-    if (byteMask & EntityMessageBits::Solid) {
-        MSG_WriteInt32(to->solid);
-    }
-
-    // Write out the Bounding Box.
-    if (byteMask & EntityMessageBits::Bounds) {
-        //MSG_WriteIntBase128(to->solid);
-		MSG_WriteUint8(-to->mins.x);
-		MSG_WriteUint8(-to->mins.y);
-		MSG_WriteUint8(-to->mins.z);
-
-		MSG_WriteUint8(to->maxs.x);
-		MSG_WriteUint8(to->maxs.y);
-		MSG_WriteUint8(to->maxs.z);
-    }
-
-    // Write out the Animation Start Time.
-    if (byteMask & EntityMessageBits::AnimationTimeStart) {
-	    MSG_WriteUintBase128(to->currentAnimation.startTime);
-    }
-    // Write out the Animation Start Frame.
-    if (byteMask & EntityMessageBits::AnimationIndex) {
-	    MSG_WriteUint8(to->currentAnimation.animationIndex);
-    }
-    //// Write out the Animation End Frame.
-    //if (byteMask & EntityMessageBits::AnimationFrameEnd) {
-	   // MSG_WriteUint16(to->animationEndFrame);
-    //}
-    //// Write out the Animation Frame Time.
-    //if (byteMask & EntityMessageBits::AnimationFrameTime) {
-    //	MSG_WriteHalfFloat(to->animationFramerate);
-    //}
+    // Write out the fields, see DeltaEntityStateFields.cpp for their order, and encoding.
+    MSG_WriteDeltaEntityStateFields(to, byteMask);
 }
\ No newline at end of file
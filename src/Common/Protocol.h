@@ -109,6 +109,10 @@ struct ServerCommand {
     static constexpr int32_t ZDownload = 17;
 	static constexpr int32_t GameState = 18;	 // q2pro specific, means svc_playerupdate in r1q2
 
+    // Multi-view demos only, precedes the frame it belongs to.
+    static constexpr int32_t PlayerStates = 19;  // [long] frame [short] count, per client: [byte] clientnum
+                                                 // [byte] flags [byte] areabytes [areabits] [delta playerstate]
+
     // This determines the maximum amount of types we can have.
 	static constexpr int32_t Maximum = 255;
 };
@@ -174,6 +178,9 @@ struct ClientCommand {
 #define EPS_BITS            7
 #define EPS_MASK            ((1<<EPS_BITS)-1)
 
+// ServerCommand::PlayerStates flag, the player state is not delta compressed
+#define EPS_NODELTA         (1<<7)
+
 //==============================================
 
 /**
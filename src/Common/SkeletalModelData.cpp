@@ -9,6 +9,7 @@
 ***/
 #include "Shared/Shared.h"
 #include "Common/Files.h"
+#include "Common/MDFour.h"
 #include "Common/SkeletalModelData.h"
 
 /**
@@ -1140,4 +1141,444 @@ bool SKM_LoadAndParseConfiguration(model_t *model, const std::string &filePath)
 
 	// Return success.
 	return true;
-}
\ No newline at end of file
+}
+
+
+/**
+*
+*
+*
+*	Binary Skeletal Model Data Cache:
+*
+*	Stores the fully generated SkeletalModelData(joints, bounding boxes, actions including
+*	their root motion distances, and animations with their blend actions) in a versioned
+*	binary file so the next load can skip both SKM_GenerateModelData and the tokenizing of
+*	the configuration file. The whole cache file is read using a single FS_LoadFile call.
+*
+*	The cache is validated against a checksum of the IQM joint/pose data and a checksum of
+*	the configuration file's text, so stale caches are regenerated automatically.
+*
+*	Cache files are stored in: 'models/path/skm/modelname.skb'
+*
+*
+**/
+//! Binary cache identifier: "SKMB"
+static constexpr uint32_t SKM_CACHE_IDENT = (('B' << 24) + ('M' << 16) + ('K' << 8) + 'S');
+//! Bump this whenever the layout of SkeletalModelData, or the cache writing code changes.
+static constexpr uint32_t SKM_CACHE_VERSION = 1;
+
+//! Binary cache file header.
+struct SKMCacheHeader {
+	//! Should equal SKM_CACHE_IDENT.
+	uint32_t ident = 0;
+	//! Should equal SKM_CACHE_VERSION.
+	uint32_t version = 0;
+	//! Checksum of the IQM joint parents, poses and bounds data.
+	uint32_t modelChecksum = 0;
+	//! Checksum of the configuration file text. (0 if there was no configuration file.)
+	uint32_t configChecksum = 0;
+	//! IQM Counts, used as a cheap sanity check before anything else.
+	uint32_t numJoints = 0;
+	uint32_t numPoses = 0;
+	uint32_t numFrames = 0;
+	//! Whether the configuration file was loaded and parsed when this cache was generated.
+	uint32_t hasConfiguration = 0;
+};
+
+/**
+*	@brief	Simple append-only writer for the binary cache buffer.
+**/
+struct SKMCacheWriter {
+	//! Cache file buffer.
+	std::vector<byte> buffer;
+
+	//! Appends raw bytes.
+	void WriteBytes( const void *data, const size_t size ) {
+		const byte *bytes = (const byte*)data;
+		buffer.insert( buffer.end(), bytes, bytes + size );
+	}
+	//! Appends a trivially copyable value.
+	template<typename T> void Write( const T &value ) {
+		static_assert( std::is_trivially_copyable_v<T>, "SKMCacheWriter can only write trivially copyable types." );
+		WriteBytes( &value, sizeof( T ) );
+	}
+	//! Appends a length prefixed string.
+	void WriteString( const std::string &str ) {
+		Write<uint32_t>( (uint32_t)str.size() );
+		WriteBytes( str.data(), str.size() );
+	}
+	//! Appends a count prefixed vector of trivially copyable values.
+	template<typename T> void WriteVector( const std::vector<T> &vec ) {
+		Write<uint32_t>( (uint32_t)vec.size() );
+		if ( !vec.empty() ) {
+			WriteBytes( vec.data(), vec.size() * sizeof( T ) );
+		}
+	}
+};
+
+/**
+*	@brief	Bounds checked reader for the binary cache buffer. Once a read has failed
+*			all further reads will fail as well, so error checking can be done once at the end.
+**/
+struct SKMCacheReader {
+	//! Buffer data.
+	const byte *data = nullptr;
+	//! Buffer size.
+	size_t size = 0;
+	//! Current read offset.
+	size_t offset = 0;
+	//! Set to true as soon as a read goes out of bounds.
+	bool overflowed = false;
+
+	//! Reads raw bytes.
+	bool ReadBytes( void *out, const size_t count ) {
+		if ( overflowed || count > size - offset ) {
+			overflowed = true;
+			return false;
+		}
+		memcpy( out, data + offset, count );
+		offset += count;
+		return true;
+	}
+	//! Reads a trivially copyable value.
+	template<typename T> T Read() {
+		T value = {};
+		ReadBytes( &value, sizeof( T ) );
+		return value;
+	}
+	//! Reads a length prefixed string.
+	std::string ReadString() {
+		const uint32_t length = Read<uint32_t>();
+		if ( overflowed || length > size - offset ) {
+			overflowed = true;
+			return "";
+		}
+		std::string str( (const char*)data + offset, length );
+		offset += length;
+		return str;
+	}
+	//! Reads a count prefixed vector of trivially copyable values.
+	template<typename T> bool ReadVector( std::vector<T> &vec ) {
+		const uint32_t count = Read<uint32_t>();
+		if ( overflowed || count > ( size - offset ) / sizeof( T ) ) {
+			overflowed = true;
+			return false;
+		}
+		vec.resize( count );
+		return ( count ? ReadBytes( vec.data(), count * sizeof( T ) ) : true );
+	}
+};
+
+/**
+*	@brief	Generates the cache file path for the model: 'models/path/skm/modelname.skb'
+**/
+static bool SKM_GetCacheFileName( const std::string &modelPath, std::string &cachePath ) {
+	// Find the file name part.
+	const size_t fileStart = ( modelPath.find_last_of( '/' ) == std::string::npos ? 0 : modelPath.find_last_of( '/' ) + 1 );
+	// Find the extension part.
+	const size_t extensionStart = modelPath.find_last_of( '.' );
+	if ( extensionStart == std::string::npos || extensionStart < fileStart ) {
+		return false;
+	}
+
+	// Generate path.
+	cachePath = modelPath.substr( 0, fileStart ) + "skm/" + modelPath.substr( fileStart, extensionStart - fileStart ) + ".skb";
+
+	return ( cachePath.size() < MAX_QPATH );
+}
+
+/**
+*	@return	A checksum of all IQM data that the skeletal model data is generated from.
+**/
+static uint32_t SKM_CalculateModelChecksum( const model_t *model ) {
+	const iqm_model_t *iqmData = model->iqmData;
+
+	uint32_t checksum = 0;
+	if ( iqmData->jointParents && iqmData->num_joints ) {
+		checksum ^= Com_BlockChecksum( iqmData->jointParents, iqmData->num_joints * sizeof( int ) );
+	}
+	if ( iqmData->poses && iqmData->num_poses && iqmData->num_frames ) {
+		checksum ^= Com_BlockChecksum( iqmData->poses, iqmData->num_poses * iqmData->num_frames * sizeof( iqm_transform_t ) );
+	}
+	if ( iqmData->bounds && iqmData->num_frames ) {
+		checksum ^= Com_BlockChecksum( iqmData->bounds, iqmData->num_frames * 6 * sizeof( float ) );
+	}
+	return checksum;
+}
+
+/**
+*	@brief	Fills in a cache header describing the current model and configuration data.
+**/
+static SKMCacheHeader SKM_GenerateCacheHeader( const model_t *model, const uint32_t configChecksum, const bool hasConfiguration ) {
+	return SKMCacheHeader {
+		.ident = SKM_CACHE_IDENT,
+		.version = SKM_CACHE_VERSION,
+		.modelChecksum = SKM_CalculateModelChecksum( model ),
+		.configChecksum = configChecksum,
+		.numJoints = model->iqmData->num_joints,
+		.numPoses = model->iqmData->num_poses,
+		.numFrames = model->iqmData->num_frames,
+		.hasConfiguration = ( hasConfiguration ? 1u : 0u ),
+	};
+}
+
+/**
+*	@brief	Serializes the model's skeletal model data and writes it out to its cache file.
+**/
+static bool SKM_SaveCachedModelData( const model_t *model, const std::string &cachePath, const SKMCacheHeader &header ) {
+	const SkeletalModelData *skm = model->skeletalModelData;
+	SKMCacheWriter writer;
+
+	/**
+	*	Header.
+	**/
+	writer.Write( header );
+
+	/**
+	*	Joints.
+	**/
+	writer.Write<uint32_t>( skm->numberOfJoints );
+	writer.Write<int32_t>( skm->rootJointIndex );
+	writer.Write<uint32_t>( (uint32_t)skm->jointMap.size() );
+	for ( auto &jointIterator : skm->jointMap ) {
+		writer.WriteString( jointIterator.second.name );
+		writer.Write<int32_t>( jointIterator.second.index );
+		writer.Write<int32_t>( jointIterator.second.parentIndex );
+	}
+
+	/**
+	*	Bounding Boxes.
+	**/
+	writer.WriteVector( skm->boundingBoxes );
+
+	/**
+	*	Actions, in index order so the actions vector can be rebuilt.
+	**/
+	writer.Write<uint32_t>( (uint32_t)skm->actionMap.size() );
+	for ( auto &actionIterator : skm->actionMap ) {
+		const SkeletalAnimationAction &action = actionIterator.second;
+
+		writer.WriteString( actionIterator.first );
+		writer.WriteString( action.name );
+		writer.Write<uint32_t>( action.index );
+		writer.Write<uint32_t>( action.startFrame );
+		writer.Write<uint32_t>( action.endFrame );
+		writer.Write<uint32_t>( action.numFrames );
+		writer.Write<double>( action.frametime );
+		writer.Write<uint32_t>( action.loopingFrames );
+		writer.Write<uint8_t>( action.forceLoop ? 1 : 0 );
+		writer.Write<double>( action.animationDistance );
+		writer.Write<double>( action.frameStartDistance );
+		writer.Write<double>( action.frameEndDistance );
+		writer.WriteVector( action.frameDistances );
+		writer.WriteVector( action.frameTranslates );
+		writer.Write<int32_t>( action.rootBoneAxisFlags );
+	}
+
+	/**
+	*	Animations, written in the order of the animations vector.
+	**/
+	writer.Write<uint32_t>( (uint32_t)skm->animations.size() );
+	for ( auto *animation : skm->animations ) {
+		writer.WriteString( animation->name );
+		writer.Write<int32_t>( animation->index );
+		writer.Write<uint32_t>( (uint32_t)animation->blendActions.size() );
+		for ( auto &blendAction : animation->blendActions ) {
+			writer.Write( blendAction );
+		}
+	}
+
+	// Write it out, FS_WriteFile takes care of creating the 'skm/' directory if needed.
+	return ( FS_WriteFile( cachePath.c_str(), writer.buffer.data(), writer.buffer.size() ) >= 0 );
+}
+
+/**
+*	@brief	Loads the skeletal model data from its cache file using a single file read.
+*	@return	False if the cache file is missing, out of date, or malformed.
+**/
+static bool SKM_LoadCachedModelData( model_t *model, const std::string &cachePath, const SKMCacheHeader &expectedHeader ) {
+	// Load the cache file in one go.
+	byte *fileBuffer = nullptr;
+	const ssize_t fileLength = FS_LoadFile( cachePath.c_str(), (void **)&fileBuffer );
+
+	if ( !fileBuffer ) {
+		return false;
+	}
+
+	SKMCacheReader reader = {
+		.data = fileBuffer,
+		.size = ( fileLength > 0 ? (size_t)fileLength : 0 ),
+	};
+
+	/**
+	*	Validate header.
+	**/
+	const SKMCacheHeader header = reader.Read<SKMCacheHeader>();
+	if ( reader.overflowed || memcmp( &header, &expectedHeader, sizeof( SKMCacheHeader ) ) != 0 ) {
+		FS_FreeFile( fileBuffer );
+		return false;
+	}
+
+	// Start off with clean skeletal model data.
+	SkeletalModelData cached;
+
+	/**
+	*	Joints.
+	**/
+	cached.numberOfJoints = reader.Read<uint32_t>();
+	cached.rootJointIndex = reader.Read<int32_t>();
+	const uint32_t numberOfJointEntries = reader.Read<uint32_t>();
+	for ( uint32_t i = 0; i < numberOfJointEntries && !reader.overflowed; i++ ) {
+		SkeletalModelData::Joint joint;
+		joint.name = reader.ReadString();
+		joint.index = reader.Read<int32_t>();
+		joint.parentIndex = reader.Read<int32_t>();
+
+		cached.jointMap[ joint.name ] = joint;
+		if ( joint.index >= 0 && joint.index < SKM_MAX_JOINTS ) {
+			cached.jointArray[ joint.index ] = joint;
+		}
+	}
+
+	/**
+	*	Bounding Boxes.
+	**/
+	reader.ReadVector( cached.boundingBoxes );
+
+	/**
+	*	Actions.
+	**/
+	const uint32_t numberOfActions = reader.Read<uint32_t>();
+	for ( uint32_t i = 0; i < numberOfActions && !reader.overflowed; i++ ) {
+		const std::string actionKey = reader.ReadString();
+		SkeletalAnimationAction &action = cached.actionMap[ actionKey ];
+
+		action.name = reader.ReadString();
+		action.index = reader.Read<uint32_t>();
+		action.startFrame = reader.Read<uint32_t>();
+		action.endFrame = reader.Read<uint32_t>();
+		action.numFrames = reader.Read<uint32_t>();
+		action.frametime = reader.Read<double>();
+		action.loopingFrames = reader.Read<uint32_t>();
+		action.forceLoop = ( reader.Read<uint8_t>() != 0 );
+		action.animationDistance = reader.Read<double>();
+		action.frameStartDistance = reader.Read<double>();
+		action.frameEndDistance = reader.Read<double>();
+		reader.ReadVector( action.frameDistances );
+		reader.ReadVector( action.frameTranslates );
+		action.rootBoneAxisFlags = reader.Read<int32_t>();
+
+		// Don't trust indices blindly.
+		if ( action.index >= numberOfActions ) {
+			reader.overflowed = true;
+			break;
+		}
+
+		// Rebuild the linear access actions list.
+		if ( cached.actions.size() <= action.index ) {
+			cached.actions.resize( action.index + 1 );
+		}
+		cached.actions[ action.index ] = &action;
+	}
+
+	/**
+	*	Animations.
+	**/
+	const uint32_t numberOfAnimations = reader.Read<uint32_t>();
+	for ( uint32_t i = 0; i < numberOfAnimations && !reader.overflowed; i++ ) {
+		const std::string animationName = reader.ReadString();
+		SkeletalAnimation &animation = cached.animationMap[ animationName ];
+
+		animation.name = animationName;
+		animation.index = reader.Read<int32_t>();
+		const uint32_t numberOfBlendActions = reader.Read<uint32_t>();
+		for ( uint32_t j = 0; j < numberOfBlendActions && !reader.overflowed; j++ ) {
+			animation.blendActions.push_back( reader.Read<SkeletalAnimationBlendAction>() );
+		}
+
+		cached.animations.push_back( &animation );
+	}
+
+	// We're done with the file buffer.
+	FS_FreeFile( fileBuffer );
+
+	// Any read failure, or trailing data, means the cache is malformed.
+	if ( reader.overflowed || reader.offset != reader.size ) {
+		Com_DPrintf( "%s: Malformed skeletal model cache '%s'\n", __func__, cachePath.c_str() );
+		return false;
+	}
+
+	// Callers index the actions and animations blindly, so each of them has to be present exactly once.
+	bool isConsistent = ( cached.actions.size() == numberOfActions && cached.actionMap.size() == numberOfActions
+						&& cached.animations.size() == numberOfAnimations && cached.animationMap.size() == numberOfAnimations );
+	for ( uint32_t i = 0; i < cached.actions.size() && isConsistent; i++ ) {
+		isConsistent = ( cached.actions[ i ] != nullptr && cached.actions[ i ]->index == i );
+	}
+	for ( uint32_t i = 0; i < cached.animations.size() && isConsistent; i++ ) {
+		const SkeletalAnimation *animation = cached.animations[ i ];
+		isConsistent = ( animation->index >= 0 && (uint32_t)animation->index < numberOfAnimations );
+		for ( auto &blendAction : animation->blendActions ) {
+			if ( blendAction.actionIndex >= numberOfActions ) {
+				isConsistent = false;
+			}
+		}
+	}
+	if ( !isConsistent ) {
+		Com_DPrintf( "%s: Inconsistent skeletal model cache '%s'\n", __func__, cachePath.c_str() );
+		return false;
+	}
+
+	// Move it into place. (std::map nodes are stable, so the action and animation pointers remain valid.)
+	*model->skeletalModelData = std::move( cached );
+
+	return true;
+}
+
+/**
+*	@brief	Loads the model's skeletal model data from its binary cache when it is up to date.
+*			Otherwise it'll generate the data the regular way(SKM_GenerateModelData and parsing
+*			the configuration file), after which it writes out a fresh cache file.
+*	@return	True if the configuration file was present and parsed successfully.
+**/
+bool SKM_LoadOrGenerateModelData( model_t *model, const std::string &modelPath, const std::string &configPath ) {
+	if ( !model || !model->iqmData || !model->skeletalModelData ) {
+		return false;
+	}
+
+	// Load the configuration file, we need its contents to validate the cache with.
+	char *configBuffer = nullptr;
+	const ssize_t configLength = FS_LoadFile( configPath.c_str(), (void **)&configBuffer );
+	const uint32_t configChecksum = ( configBuffer && configLength > 0 ? Com_BlockChecksum( configBuffer, configLength ) : 0 );
+
+	// Generate the header that a valid cache file would need to have.
+	const SKMCacheHeader header = SKM_GenerateCacheHeader( model, configChecksum, configBuffer != nullptr );
+
+	// Try to load it from cache.
+	std::string cachePath = "";
+	const bool hasCachePath = SKM_GetCacheFileName( modelPath, cachePath );
+	if ( hasCachePath && SKM_LoadCachedModelData( model, cachePath, header ) ) {
+		if ( configBuffer ) {
+			FS_FreeFile( configBuffer );
+		}
+		return ( header.hasConfiguration != 0 );
+	}
+
+	// Cache miss, generate the data from scratch.
+	*model->skeletalModelData = SkeletalModelData{};
+	SKM_GenerateModelData( model );
+
+	bool parsedConfiguration = false;
+	if ( configBuffer ) {
+		parsedConfiguration = SKM_ParseConfiguration( model, configBuffer );
+		FS_FreeFile( configBuffer );
+	}
+
+	// Only cache successful results, a failed parse would otherwise get stuck in the cache.
+	if ( hasCachePath && parsedConfiguration == header.hasConfiguration ) {
+		if ( !SKM_SaveCachedModelData( model, cachePath, header ) ) {
+			Com_DPrintf( "%s: Couldn't write skeletal model cache '%s'\n", __func__, cachePath.c_str() );
+		}
+	}
+
+	return parsedConfiguration;
+}
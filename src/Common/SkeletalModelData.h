@@ -20,4 +20,12 @@ void SKM_GenerateModelData(model_t* model);
 *			to the parsing process. The process tokenizes the data and generates game
 *			code friendly POD to work with.
 **/
-bool SKM_LoadAndParseConfiguration( model_t *model, const std::string &filePath );
\ No newline at end of file
+bool SKM_LoadAndParseConfiguration( model_t *model, const std::string &filePath );
+
+/**
+*	@brief	Loads the model's skeletal model data from its binary cache file when it is
+*			up to date with the IQM and configuration file. If not, it generates it using
+*			SKM_GenerateModelData and SKM_LoadAndParseConfiguration and writes a new cache.
+*	@return	True if the configuration file was present and parsed successfully.
+**/
+bool SKM_LoadOrGenerateModelData( model_t *model, const std::string &modelPath, const std::string &configPath );
\ No newline at end of file
@@ -12,6 +12,8 @@
 
 #include "Common/TemporaryBoneCache.h"
 
+#include <mutex>
+
 
 //! The TOTAL maximum amount of temporary bones the cache can reserve during a frame.
 //! Currently it is set to the same value as IQM_MAX_MATRICES (Look it up: /src/refresh/vkpt/shader/vertex_buffer.h)
@@ -20,39 +22,62 @@ static constexpr int32_t TBC_SIZE_MAX_CACHEBLOCK = 32768;
 //! The TOTAL maximum size for each allocated pose block.
 static constexpr int32_t TBC_SIZE_MAX_POSEBLOCK = IQM_MAX_JOINTS;
 
-//! The size of each extra reserved bone cache block.
-static constexpr int32_t TBC_SIZE_BLOCK_RESERVE = 8192;
+//! The size of each arena chunk.
+static constexpr int32_t TBC_SIZE_CHUNK = 8192; // Should allow for 32 distinct poses of size IQM_MAX_JOINTS(256).
 
-//! The actual default size of our cache.
-static constexpr int32_t TBC_SIZE_INITIAL = 8192; // Should allow for 32 distinct poses of size IQM_MAX_JOINTS(256).
 
 
+//! Only taken when a thread acquires memory from a cache for the first time, to register its arena.
+static std::mutex tbc_arenaMutex;
 
-//! Serves as a means of working with the std::vector::insert method.
-static std::vector<EntitySkeletonBonePose> _cleanBonePoses(IQM_MAX_JOINTS);
+//! The arena of the calling thread, valid as long as cache and generation match.
+static thread_local struct {
+	const TemporaryBoneCache *cache = nullptr;
+	uint64_t generation = 0;
+	TemporaryBoneCacheArena *arena = nullptr;
+} tbc_threadArena;
 
 
 
+/**
+*	@return	The calling thread's arena in the cache, registering a new one if it has none yet.
+**/
+static TemporaryBoneCacheArena *TBC_GetThreadArena( TemporaryBoneCache &cache ) {
+	if ( tbc_threadArena.cache == &cache && tbc_threadArena.generation == cache.generation && tbc_threadArena.arena ) {
+		return tbc_threadArena.arena;
+	}
+
+	std::lock_guard<std::mutex> lock( tbc_arenaMutex );
+	cache.arenas.push_back( std::make_unique<TemporaryBoneCacheArena>() );
+
+	tbc_threadArena.cache = &cache;
+	tbc_threadArena.generation = cache.generation;
+	tbc_threadArena.arena = cache.arenas.back().get();
+	tbc_threadArena.arena->frame = cache.frame;
+
+	return tbc_threadArena.arena;
+}
+
 /**
 *	@brief	Clears the Temporary Bone Cache. Does NOT reset its size to defaults. Memory stays allocated as it was.
 **/
 void TBC_ClearCache( TemporaryBoneCache &cache ) {
-	// Clear the cache.
-	cache.cache.clear();
+	// Arenas rewind themselves on their first use in the new frame.
+	cache.frame++;
+	cache.numPoses = 0;
 }
 
 /**
 *	@brief	Clears, AND resets the Temporary Bone Cache to its default size.
 **/
 void TBC_ResetCache( TemporaryBoneCache &cache ) {
-	// Clear the cache.
-	cache.cache.clear();
+	std::lock_guard<std::mutex> lock( tbc_arenaMutex );
 
-	// Reserve actual cache data.
-	cache.cache.reserve( TBC_SIZE_INITIAL );
-
-	// Ask kindly of this container will shrink to fit. (Implementation dependant.)
-	cache.cache.shrink_to_fit();
+	// Release all arenas, and their chunks. Threads register a fresh arena on their next acquire.
+	cache.arenas.clear();
+	cache.generation++;
+	cache.frame++;
+	cache.numPoses = 0;
 }
 
 /**
@@ -70,34 +95,47 @@ EntitySkeletonBonePose *TBC_AcquireCachedMemoryBlock( TemporaryBoneCache &cache,
 	/**
 	*	#0: Ensure we can properly allocate this block of memory.
 	**/
-	const size_t sizeDemand = cache.cache.size() + size - 1;
-	const size_t currentCapacity = cache.cache.capacity();
-
-//	Com_Printf("--------------------\n");
-//	Com_Printf( "TBC_AcquireCachedMemoryBlock: sizeDemand=%i, currentCapacity=%i\n", sizeDemand, currentCapacity );
 	// In case the size exceeds MAX_IQM_JOINTS, nullptr.
-	if ( size > IQM_MAX_JOINTS ) {
+	if ( size > TBC_SIZE_MAX_POSEBLOCK ) {
 		Com_DPrintf( "if ( size > IQM_MAX_JOINTS ) where size=%i\n", size );
 		return nullptr;
 	}
 
-	// Reserve extra cache memory if needed.
-	if ( sizeDemand > currentCapacity ) {
-		// We still need to be careful to never exceed TBC_SIZE_MAX_POSEBLOCK here.
-		// If it 
-		if ( sizeDemand > TBC_SIZE_MAX_CACHEBLOCK ) {
-			// TODO: Oughta warn here, or just bail out altogether.
-			Com_DPrintf( "sizeDemand > TBC_SIZE_MAX_CACHEBLOCK where sizeDemand=%i\n", sizeDemand );
-			return nullptr;
-		}
-
-		// It isn't exceeding TBC_SIZE_MAX_POSEBLOCK, so we can safely reserve another block.
-		cache.cache.reserve( currentCapacity + TBC_SIZE_BLOCK_RESERVE );
+	// Never exceed TBC_SIZE_MAX_CACHEBLOCK for all threads combined.
+	const uint32_t sizeDemand = cache.numPoses.fetch_add( size, std::memory_order_relaxed ) + size;
+	if ( sizeDemand > TBC_SIZE_MAX_CACHEBLOCK ) {
+		cache.numPoses.fetch_sub( size, std::memory_order_relaxed );
+		// TODO: Oughta warn here, or just bail out altogether.
+		Com_DPrintf( "sizeDemand > TBC_SIZE_MAX_CACHEBLOCK where sizeDemand=%i\n", sizeDemand );
+		return nullptr;
 	}
 
 	/**
-	*	#1: Insert (actually initialize and allocate memory if it has not done so before.), and return address.
+	*	#1: Hand out the block from this thread's arena, moving on to the next chunk if it does not fit.
 	**/
-	// Insert into our container to initialize the needed memory.
-	return &(*cache.cache.insert(cache.cache.end(), _cleanBonePoses.begin(), _cleanBonePoses.begin() + size - 1));
-}
\ No newline at end of file
+	TemporaryBoneCacheArena *arena = TBC_GetThreadArena( cache );
+
+	// Rewind the arena on its first use in this frame.
+	if ( arena->frame != cache.frame ) {
+		arena->chunkIndex = 0;
+		arena->chunkOffset = 0;
+		arena->frame = cache.frame;
+	}
+
+	if ( arena->chunkIndex < arena->chunks.size() && arena->chunkOffset + size > TBC_SIZE_CHUNK ) {
+		arena->chunkIndex++;
+		arena->chunkOffset = 0;
+	}
+	// Chunks are allocated once, and never resized, so earlier blocks stay put.
+	if ( arena->chunkIndex >= arena->chunks.size() ) {
+		arena->chunks.emplace_back( TBC_SIZE_CHUNK );
+	}
+
+	EntitySkeletonBonePose *block = &arena->chunks[arena->chunkIndex][arena->chunkOffset];
+	arena->chunkOffset += size;
+
+	// Hand it out clean.
+	std::fill_n( block, size, EntitySkeletonBonePose{} );
+
+	return block;
+}
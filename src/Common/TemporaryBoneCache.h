@@ -13,6 +13,9 @@
 *	At each new start of a map the cache is cleared. If during gameplay the cache grows it only allocates
 *	this memory once, and keeps it allocated until the map ends.
 *
+*	Each thread acquires its memory from its own arena of fixed size chunks, so no locking is needed and
+*	blocks handed out earlier in the frame are never moved.
+*
 ***/
 #pragma once
 
@@ -20,24 +23,45 @@
 // We need to know about our EntitySkeletonBonePose type.
 #include "Shared/EntitySkeleton.h"
 
+#include <atomic>
+
 /**
-*	@brief	Currently only contains our vector cache container.
+*	@brief	A per thread sub-arena of the bone cache. Memory is handed out linearly from fixed size
+*			chunks. Chunks are never reallocated, so handed out blocks stay valid for the whole frame.
 **/
-struct TemporaryBoneCache {
-	//! This is the actual cache container to which each frame the Game Modules can request 
-	//! a block of memory from.
-	std::vector<EntitySkeletonBonePose> cache;
+struct TemporaryBoneCacheArena {
+	//! Fixed size chunks of TBC_SIZE_CHUNK bone poses each.
+	std::vector<std::vector<EntitySkeletonBonePose>> chunks;
+	//! Current chunk, and offset within it to hand out the next block from.
+	uint32_t chunkIndex = 0;
+	uint32_t chunkOffset = 0;
+	//! Frame this arena was last reset for. It resets itself lazily on its first use in a new frame.
+	uint64_t frame = 0;
+};
 
-	//! Nothing here yet.
+/**
+*	@brief	Frame scoped bone cache with a sub-arena for each thread that acquires memory from it.
+**/
+struct TemporaryBoneCache {
+	//! One arena for each thread that has acquired memory from this cache.
+	std::vector<std::unique_ptr<TemporaryBoneCacheArena>> arenas;
+	//! Incremented by each TBC_ClearCache call, invalidating all blocks handed out before.
+	uint64_t frame = 0;
+	//! Incremented by each TBC_ResetCache call, so threads look up their arena again.
+	uint64_t generation = 0;
+	//! Total amount of bone poses handed out this frame, across all threads.
+	std::atomic<uint32_t> numPoses = 0;
 };
 
 /**
 *	@brief	Clears the Temporary Bone Cache. Does NOT reset its size to defaults. Memory stays allocated as it was.
+*			Must be called while no other thread is acquiring memory from the cache.
 **/
 void TBC_ClearCache( TemporaryBoneCache &cache );
 
 /**
 *	@brief	Clears, AND resets the Temporary Bone Cache to its default size.
+*			Must be called while no other thread is acquiring memory from the cache.
 **/
 void TBC_ResetCache( TemporaryBoneCache &cache );
 
@@ -51,5 +75,8 @@ void TBC_ResetCache( TemporaryBoneCache &cache );
 *			
 *			If you need a larger temporary bone cache than both IQM_MAX_MATRICES as well as TBC_SIZE_MAX_POSEBLOCK
 *			need to be increased in a higher, and equally same number.
+*
+*			Safe to call from multiple threads at once, each thread allocates from its own arena. The returned
+*			block remains valid until the next TBC_ClearCache.
 **/
 EntitySkeletonBonePose *TBC_AcquireCachedMemoryBlock( TemporaryBoneCache &cache, uint32_t size = IQM_MAX_JOINTS );
\ No newline at end of file
@@ -522,6 +522,95 @@ static void Com_TestModels_f(void)
 
     FS_FreeList(list);
 }
+
+// decodes every texture both on the spot and on the decode threads,
+// without uploading anything, and checks that the results match
+static void Com_TestImages_f(void)
+{
+    void **list;
+    int i, count, errors;
+    unsigned start, end;
+    qerror_t ret;
+
+    list = FS_ListFiles("textures", "*.tga;*.jpg;*.png", FS_SEARCH_SAVEPATH | FS_SEARCH_BYFILTER, &count);
+    if (!list) {
+        Com_Printf("No images found\n");
+        return;
+    }
+
+    start = Sys_Milliseconds();
+
+    errors = 0;
+    for (i = 0; i < count; i++) {
+        ret = IMG_TestDecode((char *)list[i]);
+        if (ret) {
+            Com_EPrintf("IMG_TestDecode( \"%s\" ) failed: %s\n",
+                        (char *)list[i], Q_ErrorString(ret));
+            errors++;
+        }
+    }
+
+    end = Sys_Milliseconds();
+
+    Com_Printf("%d msec, %d failures, %d images tested\n",
+               end - start, errors, count);
+
+    FS_FreeList(list);
+}
+
+/*
+=============
+Com_BenchImages_f
+
+imagebench [file ...]
+
+Times the plain C and SIMD image kernels on the given files, or on all
+WAL and PNG textures.
+=============
+*/
+static void Com_BenchImages_f(void)
+{
+    static const char *const kernels[IMG_BENCH_KERNELS] = { "mipmap", "resample", "srgb" };
+    double times[2][IMG_BENCH_KERNELS];
+    void **list;
+    const char *name;
+    int i, count, tested;
+    qerror_t ret;
+
+    if (Cmd_Argc() > 1) {
+        list = NULL;
+        count = Cmd_Argc() - 1;
+    } else {
+        list = FS_ListFiles("textures", "*.wal;*.png", FS_SEARCH_SAVEPATH | FS_SEARCH_BYFILTER, &count);
+        if (!list) {
+            Com_Printf("No images found\n");
+            return;
+        }
+    }
+
+    memset(times, 0, sizeof(times));
+    tested = 0;
+    for (i = 0; i < count; i++) {
+        name = list ? (char *)list[i] : Cmd_Argv(i + 1);
+        ret = IMG_Benchmark(name, times);
+        if (ret) {
+            Com_EPrintf("IMG_Benchmark( \"%s\" ) failed: %s\n",
+                        name, Q_ErrorString(ret));
+            continue;
+        }
+        tested++;
+    }
+
+    Com_Printf("%d images benchmarked\n", tested);
+    for (i = 0; i < IMG_BENCH_KERNELS; i++) {
+        Com_Printf("%-10s %8.2f ms c %8.2f ms %s\n", kernels[i],
+                   times[0][i], times[1][i], i == 2 ? "table" : "simd");
+    }
+
+    if (list) {
+        FS_FreeList(list);
+    }
+}
 #endif
 
 void TST_Init(void)
@@ -538,6 +627,8 @@ void TST_Init(void)
     Cmd_AddCommand("snprintftest", Com_TestSnprintf_f);
 #if USE_REF
     Cmd_AddCommand("modeltest", Com_TestModels_f);
+    Cmd_AddCommand("imagetest", Com_TestImages_f);
+    Cmd_AddCommand("imagebench", Com_BenchImages_f);
 #endif
 }
 
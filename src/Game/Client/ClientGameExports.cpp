@@ -18,6 +18,9 @@
 #include "Effects/LightStyles.h"
 #include "Effects/Particles.h"
 
+#include "Entities/PacketEntityInterpolation.h"
+#include "Entities/SkeletalPoseCache.h"
+
 //! Static 
 ClientGameExports *clge = nullptr;
 
@@ -76,6 +79,8 @@ void ClientGameExports::DemoSeek() {
     Particles::Clear();
     // Clear Dynamic Light Effects.
     DynamicLights::Clear();
+    // Clear Interpolation Records.
+    PacketEntityInterpolation::Clear();
 
     // Clear Temp Entities.
     CLG_ClearTempEntities();
@@ -155,12 +160,18 @@ void ClientGameExports::ClientClearState() {
     Particles::Clear();
     // Clear Dynamic Light Effects.
     DynamicLights::Clear();
+    // Clear cached prediction results.
+    prediction->ClearPredictionCache();
+    // Clear Interpolation Records.
+    PacketEntityInterpolation::Clear();
 
     // WID: TODO: I think this #ifdef can go lol.
 #if USE_LIGHTSTYLES
     LightStyles::Clear();
 #endif
     CLG_ClearTempEntities();
+	// Model handles are reassigned per map, flush the cached poses.
+	SkeletalPoseCache::Clear();
 
 	// Notify our game locals about shutting down.
 	game.Shutdown();
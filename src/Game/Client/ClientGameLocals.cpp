@@ -60,11 +60,20 @@ cvar_t *cl_noglow               = nullptr;
 cvar_t *cl_noskins              = nullptr;
 cvar_t *cl_player_model         = nullptr;
 cvar_t *cl_predict              = nullptr;
+cvar_t *cl_predict_cache        = nullptr;
+cvar_t *cl_predict_showstats    = nullptr;
 cvar_t *cl_rollhack             = nullptr;
 cvar_t *cl_thirdperson_angle    = nullptr;
 cvar_t *cl_thirdperson_range    = nullptr;
 cvar_t *cl_vwep                 = nullptr;
 
+cvar_t *cl_anim_lod             = nullptr;
+cvar_t *cl_anim_lod_distance1   = nullptr;
+cvar_t *cl_anim_lod_distance2   = nullptr;
+cvar_t *cl_anim_lod_bonedepth   = nullptr;
+cvar_t *cl_anim_lod_showstats   = nullptr;
+cvar_t *cl_anim_parallel        = nullptr;
+
 // Refresh.
 cvar_t* cvar_pt_beam_lights     = nullptr;
 
@@ -366,11 +366,21 @@ extern cvar_t* cl_noglow;
 extern cvar_t* cl_noskins;
 extern cvar_t* cl_player_model;
 extern cvar_t* cl_predict;
+extern cvar_t* cl_predict_cache;        // Reuses the predicted player moves of unchanged commands in between server frames.
+extern cvar_t* cl_predict_showstats;
 extern cvar_t* cl_rollhack;
 extern cvar_t* cl_thirdperson_angle;
 extern cvar_t* cl_thirdperson_range;
 extern cvar_t* cl_vwep;
 
+// Animation LOD.
+extern cvar_t* cl_anim_lod;             // 0 disables animation LOD, all entities animate at full detail.
+extern cvar_t* cl_anim_lod_distance1;   // Distance beyond which blend layers are skipped and poses update every 2nd frame.
+extern cvar_t* cl_anim_lod_distance2;   // Distance beyond which only bones up to cl_anim_lod_bonedepth are lerped, every 4th frame.
+extern cvar_t* cl_anim_lod_bonedepth;
+extern cvar_t* cl_anim_lod_showstats;
+extern cvar_t* cl_anim_parallel;        // Computes skeletal entity poses on the worker threads.
+
 // Refresh... TODO: Move.
 extern cvar_t* cvar_pt_beam_lights;
 
@@ -16,6 +16,14 @@
 #include "ParticleEffects.h"
 #include "Particles.h"
 
+//! SSE2 is the baseline on x86-64, other targets use the scalar path.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLG_PARTICLES_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define CLG_PARTICLES_USE_SSE2 0
+#endif
+
 
 //! Particle emissive factor.
 cvar_t *Particles::cvar_pt_particle_emissive = nullptr;
@@ -26,13 +34,14 @@ cvar_t *Particles::cl_particle_num_factor = nullptr;
 //! Precalculated angular velocities.
 vec3_t Particles::angularVelocities[MaxAngularVelocities] = {};
 
-//! Pointer to active particles.
-cparticle_t *Particles::activeParticles;
-//! Pointer to free particles.
-cparticle_t *Particles::freeParticles;
+//! Particles handed out by GetFreeParticle, waiting to be moved into the particle store.
+cparticle_t Particles::spawnedParticles[MaxSpawnedParticles] = {};
+int32_t Particles::numSpawnedParticles = 0;
 
-//! Actual particle storage array.
-cparticle_t  Particles::particles[MAX_PARTICLES] = {};
+//! The particle store.
+Particles::ParticleStore Particles::particleStore = {};
+//! Number of alive particles in the particle store.
+int32_t Particles::numParticles = 0;
 
 
 /**
@@ -61,18 +70,9 @@ void Particles::Shutdown() {
 *   @brief  Clear/Reset the particles for a new frame.
 **/
 void Particles::Clear() {
-    // Reset the free particles pointer. (Defaults to index 0 ofc.)
-    freeParticles = &particles[0];
-    // Reset active to nullptr.
-    activeParticles = nullptr;
-
-    // Reset the next particle pointers for each one of them.
-    for (int32_t i = 0; i < cl_numparticles; i++) {
-        particles[i].next = &particles[i + 1];
-    }
-
-    // Last one gets a nullptr signifying the end.
-    particles[cl_numparticles - 1].next = nullptr;
+    // Drop all spawned, and stored particles.
+    numSpawnedParticles = 0;
+    numParticles = 0;
 }
 
 /**
@@ -81,95 +81,173 @@ void Particles::Clear() {
 **/
 cparticle_t* Particles::GetFreeParticle() {
     // No more free particles left, return nullptr.
-    if (!freeParticles) {
+    if (numSpawnedParticles >= MaxSpawnedParticles || numParticles + numSpawnedParticles >= MaxParticles) {
         return nullptr;
     }
 
-    // Assign the first free particle in town.
-    cparticle_t *particle = freeParticles;
+    // Hand out the next spawn slot, it is moved into the store by AddParticlesToView.
+    cparticle_t *particle = &spawnedParticles[numSpawnedParticles++];
+    *particle = {};
 
-    // Increment its pointer to the next free particle.
-    freeParticles = particle->next;
+    // Last but not least, return it.
+    return particle;
+}
 
-    // For the currently "allocated" particle we set the next pointer to the first active
-    // particle one. 
-    particle->next = activeParticles;
+/**
+*   @brief  Moves the particles spawned since the last call over into the particle store.
+**/
+void Particles::StoreSpawnedParticles() {
+    for (int32_t i = 0; i < numSpawnedParticles; i++) {
+        const cparticle_t &particle = spawnedParticles[i];
+        const int32_t index = numParticles++;
+
+        particleStore.originX[index] = particle.org.x;
+        particleStore.originY[index] = particle.org.y;
+        particleStore.originZ[index] = particle.org.z;
+        particleStore.velocityX[index] = particle.vel.x;
+        particleStore.velocityY[index] = particle.vel.y;
+        particleStore.velocityZ[index] = particle.vel.z;
+        particleStore.accelerationX[index] = particle.acceleration.x;
+        particleStore.accelerationY[index] = particle.acceleration.y;
+        particleStore.accelerationZ[index] = particle.acceleration.z;
+        particleStore.time[index] = particle.time;
+        particleStore.alpha[index] = particle.alpha;
+        particleStore.alphaVelocity[index] = particle.alphavel;
+        particleStore.color[index] = particle.color;
+        particleStore.rgba[index] = particle.rgba;
+        particleStore.brightness[index] = particle.brightness;
+    }
 
-    // Update the active particle pointer to match our current fresh particle.
-    activeParticles = particle;
+    numSpawnedParticles = 0;
+}
 
-    // Last but not least, return it.
-    return particle;
+/**
+*   @brief  Evaluates the origin and alpha of all stored particles at time, in
+*           groups of 4, into the particle store's render arrays.
+**/
+void Particles::IntegrateParticles(const float time) {
+    ParticleStore &store = particleStore;
+
+    // MaxParticles is a multiple of 4, so the last group never reads past the arrays.
+    static_assert(MaxParticles % 4 == 0, "MaxParticles has to be a multiple of 4");
+
+#if CLG_PARTICLES_USE_SSE2
+    const __m128 frameTime = _mm_set1_ps(time);
+    const __m128 millisecondsToSeconds = _mm_set1_ps(0.001f);
+    const __m128 instantParticle = _mm_set1_ps(ParticleEffects::InstantParticle);
+
+    for (int32_t i = 0; i < numParticles; i += 4) {
+        // Instant particles are displayed as spawned.
+        const __m128 alphaVelocity = _mm_load_ps(&store.alphaVelocity[i]);
+        const __m128 isInstant = _mm_cmpeq_ps(alphaVelocity, instantParticle);
+        const __m128 t = _mm_andnot_ps(isInstant, _mm_mul_ps(_mm_sub_ps(frameTime, _mm_load_ps(&store.time[i])), millisecondsToSeconds));
+        const __m128 t2 = _mm_mul_ps(t, t);
+
+        // origin + velocity * t + acceleration * t * t.
+        _mm_store_ps(&store.renderOriginX[i], _mm_add_ps(_mm_load_ps(&store.originX[i]), _mm_add_ps(_mm_mul_ps(_mm_load_ps(&store.velocityX[i]), t), _mm_mul_ps(_mm_load_ps(&store.accelerationX[i]), t2))));
+        _mm_store_ps(&store.renderOriginY[i], _mm_add_ps(_mm_load_ps(&store.originY[i]), _mm_add_ps(_mm_mul_ps(_mm_load_ps(&store.velocityY[i]), t), _mm_mul_ps(_mm_load_ps(&store.accelerationY[i]), t2))));
+        _mm_store_ps(&store.renderOriginZ[i], _mm_add_ps(_mm_load_ps(&store.originZ[i]), _mm_add_ps(_mm_mul_ps(_mm_load_ps(&store.velocityZ[i]), t), _mm_mul_ps(_mm_load_ps(&store.accelerationZ[i]), t2))));
+
+        // alpha + alphaVelocity * t.
+        _mm_store_ps(&store.renderAlpha[i], _mm_add_ps(_mm_load_ps(&store.alpha[i]), _mm_mul_ps(alphaVelocity, t)));
+    }
+#else
+    for (int32_t i = 0; i < numParticles; i++) {
+        // Instant particles are displayed as spawned.
+        const float t = (store.alphaVelocity[i] != ParticleEffects::InstantParticle ? (time - store.time[i]) * 0.001f : 0.f);
+        const float t2 = t * t;
+
+        store.renderOriginX[i] = store.originX[i] + store.velocityX[i] * t + store.accelerationX[i] * t2;
+        store.renderOriginY[i] = store.originY[i] + store.velocityY[i] * t + store.accelerationY[i] * t2;
+        store.renderOriginZ[i] = store.originZ[i] + store.velocityZ[i] * t + store.accelerationZ[i] * t2;
+        store.renderAlpha[i] = store.alpha[i] + store.alphaVelocity[i] * t;
+    }
+#endif
 }
 
-void Particles::AddParticlesToView(void)
-{
-    cparticle_t* particle, * nextParticle;
-    float           alpha;
-    float           time = 0, time2;
-    int             color;
-    cparticle_t* active, * tail;
-    rparticle_t renderParticle;
-
-    active = NULL;
-    tail = NULL;
-
-    for (particle = activeParticles; particle; particle = nextParticle) {
-        nextParticle = particle->next;
-
-        if (particle->alphavel != ParticleEffects::InstantParticle) {
-            time = (cl->time - particle->time) * 0.001;
-            alpha = particle->alpha + time * particle->alphavel;
-
-            if (alpha <= 0) {
-                // Faded out.
-                particle->next = freeParticles;
-                freeParticles = particle;
-                continue;
-            }
-        }
-        else {
-            alpha = particle->alpha;
-        }
+/**
+*   @brief  Removes the particle at index by moving the last particle into its place.
+**/
+void Particles::RemoveParticle(const int32_t index) {
+    ParticleStore &store = particleStore;
+    const int32_t last = --numParticles;
 
-        particle->next = nullptr;
-        if (!tail)
-            active = tail = particle;
-        else {
-            tail->next = particle;
-            tail = particle;
-        }
+    if (index == last) {
+        return;
+    }
+
+    store.originX[index] = store.originX[last];
+    store.originY[index] = store.originY[last];
+    store.originZ[index] = store.originZ[last];
+    store.velocityX[index] = store.velocityX[last];
+    store.velocityY[index] = store.velocityY[last];
+    store.velocityZ[index] = store.velocityZ[last];
+    store.accelerationX[index] = store.accelerationX[last];
+    store.accelerationY[index] = store.accelerationY[last];
+    store.accelerationZ[index] = store.accelerationZ[last];
+    store.time[index] = store.time[last];
+    store.alpha[index] = store.alpha[last];
+    store.alphaVelocity[index] = store.alphaVelocity[last];
+    store.color[index] = store.color[last];
+    store.rgba[index] = store.rgba[last];
+    store.brightness[index] = store.brightness[last];
+    store.renderOriginX[index] = store.renderOriginX[last];
+    store.renderOriginY[index] = store.renderOriginY[last];
+    store.renderOriginZ[index] = store.renderOriginZ[last];
+    store.renderAlpha[index] = store.renderAlpha[last];
+}
 
-        if (alpha > 1.0)
-            alpha = 1;
-        color = particle->color;
+/**
+*   @brief  Moves the newly spawned particles into the particle store, integrates all
+*           particles, removes the faded out ones, and adds the rest to the view.
+**/
+void Particles::AddParticlesToView() {
+    ParticleStore &store = particleStore;
+
+    // Take in the particles spawned since last frame, and evaluate them all at the current time.
+    StoreSpawnedParticles();
+    IntegrateParticles((float)cl->time);
+
+    // Remove the faded out particles.
+    for (int32_t i = 0; i < numParticles; ) {
+        if (store.renderAlpha[i] <= 0) {
+            // The last particle takes its place, so check this index again.
+            RemoveParticle(i);
+        } else {
+            i++;
+        }
+    }
 
-        time2 = time * time;
+    // Add the remaining particles to the view.
+    rparticle_t renderParticle = {};
+    for (int32_t i = 0; i < numParticles; i++) {
+        const float alpha = Minf(store.renderAlpha[i], 1.f);
+        const int32_t color = store.color[i];
 
-        renderParticle.origin = particle->org + particle->vel * time + particle->acceleration * time2;
+        renderParticle.origin = { store.renderOriginX[i], store.renderOriginY[i], store.renderOriginZ[i] };
 
         if (color == -1) {
-            renderParticle.rgba.u8[0] = particle->rgba.u8[0];
-            renderParticle.rgba.u8[1] = particle->rgba.u8[1];
-            renderParticle.rgba.u8[2] = particle->rgba.u8[2];
-            renderParticle.rgba.u8[3] = particle->rgba.u8[3] * alpha;
+            renderParticle.rgba.u8[0] = store.rgba[i].u8[0];
+            renderParticle.rgba.u8[1] = store.rgba[i].u8[1];
+            renderParticle.rgba.u8[2] = store.rgba[i].u8[2];
+            renderParticle.rgba.u8[3] = store.rgba[i].u8[3] * alpha;
         }
 
         renderParticle.color = color;
-        renderParticle.brightness = particle->brightness;
+        renderParticle.brightness = store.brightness[i];
         renderParticle.alpha = alpha;
         renderParticle.radius = 0.f;
 
-        if (particle->alphavel == ParticleEffects::InstantParticle) {
-            particle->alphavel = 0.0;
-            particle->alpha = 0.0;
-        }
-
-        // Break out the first second we even notice there's no more slots left.
+        // Break out the first second we even notice there's no more slots left. The particles
+        // that did not make it remain stored, and are retried next frame.
         if (!clge->view->AddRenderParticle(renderParticle)) {
             break;
         }
-    }
 
-    activeParticles = active;
+        // Instant particles are only displayed for a single frame.
+        if (store.alphaVelocity[i] == ParticleEffects::InstantParticle) {
+            store.alphaVelocity[i] = 0.f;
+            store.alpha[i] = 0.f;
+        }
+    }
 }
\ No newline at end of file
@@ -47,7 +47,8 @@ public:
     static cparticle_t *GetFreeParticle();
 
     /**
-    *   @brief  Adds the 
+    *   @brief  Moves the newly spawned particles into the particle store, integrates all
+    *           particles, removes the faded out ones, and adds the rest to the view.
     **/
     static void AddParticlesToView();
 
@@ -77,12 +78,62 @@ private:
     //! Precalculated angular velocities.
     static vec3_t angularVelocities[MaxAngularVelocities];
 
-    //! Pointer to active particles.
-    static cparticle_t *activeParticles;
-    //! Pointer to free particles.
-    static cparticle_t *freeParticles;
+    /**
+    *   @brief  Moves the particles spawned since the last call over into the particle store.
+    **/
+    static void StoreSpawnedParticles();
+    /**
+    *   @brief  Evaluates the origin and alpha of all stored particles at time, in
+    *           groups of 4, into the particle store's render arrays.
+    **/
+    static void IntegrateParticles(const float time);
+    /**
+    *   @brief  Removes the particle at index by moving the last particle into its place.
+    **/
+    static void RemoveParticle(const int32_t index);
+
+    //! Maximum amount of simulated particles. The view itself is still limited to 
+    //! MAX_PARTICLES render particles per frame.
+    static constexpr int32_t MaxParticles = MAX_PARTICLES * 4;
+    //! Maximum amount of particles that can be spawned in between two AddParticlesToView calls.
+    static constexpr int32_t MaxSpawnedParticles = MAX_PARTICLES;
+
+    //! Particles handed out by GetFreeParticle, waiting to be moved into the particle store.
+    static cparticle_t spawnedParticles[MaxSpawnedParticles];
+    static int32_t numSpawnedParticles;
+
+    /**
+    *   @brief  Structure of arrays particle storage. Alive particles are kept packed
+    *           in [0, numParticles).
+    **/
+    struct ParticleStore {
+        //! Spawn origin, velocity and acceleration.
+        alignas(16) float originX[MaxParticles];
+        alignas(16) float originY[MaxParticles];
+        alignas(16) float originZ[MaxParticles];
+        alignas(16) float velocityX[MaxParticles];
+        alignas(16) float velocityY[MaxParticles];
+        alignas(16) float velocityZ[MaxParticles];
+        alignas(16) float accelerationX[MaxParticles];
+        alignas(16) float accelerationY[MaxParticles];
+        alignas(16) float accelerationZ[MaxParticles];
+        //! Spawn time, alpha, and alpha velocity.
+        alignas(16) float time[MaxParticles];
+        alignas(16) float alpha[MaxParticles];
+        alignas(16) float alphaVelocity[MaxParticles];
+        //! Color, or -1 to use rgba.
+        int32_t color[MaxParticles];
+        color_t rgba[MaxParticles];
+        float brightness[MaxParticles];
 
-    //! Actual particle storage array.
-    static cparticle_t  particles[MAX_PARTICLES];
-    static constexpr int32_t cl_numparticles = MAX_PARTICLES;
-};
+        //! Origin and alpha at the current frame's time, written by IntegrateParticles.
+        alignas(16) float renderOriginX[MaxParticles];
+        alignas(16) float renderOriginY[MaxParticles];
+        alignas(16) float renderOriginZ[MaxParticles];
+        alignas(16) float renderAlpha[MaxParticles];
+    };
+    //! The particle store.
+    static ParticleStore particleStore;
+    //! Number of alive particles in the particle store.
+    static int32_t numParticles;
+};
\ No newline at end of file
@@ -27,9 +27,16 @@
 // Effects.
 #include "../../Effects/ParticleEffects.h"
 
+// Interpolation records.
+#include "../PacketEntityInterpolation.h"
+
+// Shared poses of distant skeletal entities.
+#include "../SkeletalPoseCache.h"
+
 // Base Entity.
 #include "CLGBasePacketEntity.h"
 
+
 //! Here for OnEvent handling.
 extern qhandle_t cl_sfx_footsteps[4];
 
@@ -39,6 +46,10 @@ vec3_t CLGBasePacketEntity::ZeroVec3 = vec3_zero();
 //! Used for returning strings from a const std::string & reference.
 std::string CLGBasePacketEntity::EmptyString = "";
 
+//! Animation LOD statistics, and frame counter.
+CLGBasePacketEntity::AnimationLODStatistics CLGBasePacketEntity::animationLODStatistics = {};
+int64_t CLGBasePacketEntity::animationLODFrame = 0;
+
 /**
 *
 *   Constructor/Destructor AND TypeInfo related.
@@ -1227,12 +1238,21 @@ void CLGBasePacketEntity::ComputeEntitySkeletonTransforms( EntitySkeletonBonePos
 			return;
 		}
 
-		// Allocate a cached memory block for the dominating blend action. (Our main action timeline.)
-		EntitySkeletonBonePose *dominatingBlendPose = clgi.TBC_AcquireCachedMemoryBlock( model->iqmData->num_poses );
-		
 		// Get the dominating blend action state.
 		EntitySkeletonBlendActionState *dominatingBlendActionState = &entitySkeleton.blendActionAnimationStates[0][0];
 
+		// Distant entities take the reduced animation LOD path.
+		const int32_t animationLODLevel = CalculateAnimationLOD();
+		animationLODStatistics.entities[animationLODLevel]++;
+		if ( animationLODLevel > 0 ) {
+			ComputeAnimationLODPoses( animationLODLevel, dominatingBlendAction->actionIndex, dominatingBlendActionState );
+			return;
+		}
+		animationLOD.lastUpdateFrame = -1;
+
+		// Allocate a cached memory block for the dominating blend action. (Our main action timeline.)
+		EntitySkeletonBonePose *dominatingBlendPose = clgi.TBC_AcquireCachedMemoryBlock( model->iqmData->num_poses );
+
 		// Lerp the blend action skeleton pose.
 		clgi.ES_LerpSkeletonPoses( &entitySkeleton, 
 									dominatingBlendPose,
@@ -1241,6 +1261,7 @@ void CLGBasePacketEntity::ComputeEntitySkeletonTransforms( EntitySkeletonBonePos
 									dominatingBlendActionState->backLerp, 
 									refreshEntity.rootBoneAxisFlags
 		);
+		animationLODStatistics.evaluatedBones += model->iqmData->num_poses;
 
 		// Assign our currentbonePose pointer. It gets unset in case of any issues. (Better not render than glitch render.)
 		refreshEntity.currentBonePoses = dominatingBlendPose;
@@ -1273,6 +1294,7 @@ void CLGBasePacketEntity::ComputeEntitySkeletonTransforms( EntitySkeletonBonePos
 												baState->backLerp, 
 												refreshEntity.rootBoneAxisFlags
 					);
+					animationLODStatistics.evaluatedBones += model->iqmData->num_poses;
 
 					// Now, see if the node exists and blend right on top of it.
 					const int32_t boneNumber = subdominatingBlendAction->boneNumber;
@@ -1309,6 +1331,184 @@ void CLGBasePacketEntity::ComputeEntitySkeletonTransforms( EntitySkeletonBonePos
 }
 
 
+/**
+*	@brief	Lerps the action's bone poses for the blend action state into outBonePoses at a
+*			quantized back lerp, sharing them with other entities through the skeletal pose cache.
+**/
+void CLGBasePacketEntity::LerpCachedActionPoses( EntitySkeletonBonePose *outBonePoses, const int32_t actionIndex, const EntitySkeletonBlendActionState *blendActionState ) {
+	const model_t *model = entitySkeleton.modelPtr;
+	const uint32_t numPoses = model->iqmData->num_poses;
+
+	const int32_t lerpBucket = SkeletalPoseCache::QuantizeLerp( (float)blendActionState->backLerp );
+	const SkeletalPoseCacheKey cacheKey = {
+		.modelHandle = cl->drawModels[ podEntity->currentState.modelIndex ],
+		.actionIndex = actionIndex,
+		.frame = blendActionState->currentFrame,
+		.oldFrame = blendActionState->oldFrame,
+		.lerpBucket = lerpBucket,
+		.rootBoneAxisFlags = refreshEntity.rootBoneAxisFlags,
+	};
+
+	// Copied over on a hit, blending modifies the poses in place.
+	if ( SkeletalPoseCache::Find( cacheKey, outBonePoses, numPoses ) ) {
+		return;
+	}
+
+	clgi.ES_LerpSkeletonPoses( &entitySkeleton, 
+								outBonePoses,
+								blendActionState->currentFrame, 
+								blendActionState->oldFrame, 
+								SkeletalPoseCache::DequantizeLerp( lerpBucket ), 
+								refreshEntity.rootBoneAxisFlags
+	);
+
+	SkeletalPoseCache::Store( cacheKey, outBonePoses, numPoses );
+}
+
+
+/**
+*	@brief	Gathers the indices of all bones that are at most maximumDepth levels below boneNode.
+**/
+static void CLG_GatherBoneIndicesToDepth( EntitySkeletonBoneNode &boneNode, const int32_t depth, const int32_t maximumDepth, std::vector<int32_t> &boneIndices ) {
+	const EntitySkeletonBone *esBone = boneNode.GetEntitySkeletonBone();
+	if ( !esBone || esBone->index < 0 || depth > maximumDepth ) {
+		return;
+	}
+
+	boneIndices.push_back( esBone->index );
+
+	for ( auto &childBoneNode : boneNode.GetChildren() ) {
+		CLG_GatherBoneIndicesToDepth( childBoneNode, depth + 1, maximumDepth, boneIndices );
+	}
+}
+
+/**
+*	@return	The animation LOD level for this entity based on its view distance, scaled by
+*			the field of view. 0 is full detail, 2 the lowest.
+**/
+const int32_t CLGBasePacketEntity::CalculateAnimationLOD() {
+	if ( !cl_anim_lod->integer ) {
+		return 0;
+	}
+
+	// Scale the distance by the field of view so zooming in brings back detail.
+	const vec3_t viewOrigin = clge->view->GetViewCamera()->GetViewOrigin();
+	const float fovScale = tanf( Radians( Clampf( cl->fov_x, 1.f, 179.f ) ) * 0.5f );
+	const float distance = vec3_distance( viewOrigin, podEntity->currentState.origin ) * fovScale;
+
+	if ( distance > cl_anim_lod_distance2->value ) {
+		return 2;
+	} else if ( distance > cl_anim_lod_distance1->value ) {
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+*	@brief	Computes the bone poses at a reduced animation LOD level.
+**/
+void CLGBasePacketEntity::ComputeAnimationLODPoses( const int32_t lodLevel, const int32_t actionIndex, const EntitySkeletonBlendActionState *blendActionState ) {
+	const uint32_t numPoses = entitySkeleton.modelPtr->iqmData->num_poses;
+
+	// Reuse the previous pose until it is time for the next update.
+	const int64_t updateInterval = 1LL << lodLevel;
+	if ( animationLOD.lastUpdateFrame >= 0 && animationLOD.bonePoses.size() == numPoses 
+		&& animationLODFrame - animationLOD.lastUpdateFrame < updateInterval ) {
+		refreshEntity.currentBonePoses = animationLOD.bonePoses.data();
+		animationLODStatistics.reusedPoses++;
+		return;
+	}
+
+	animationLOD.bonePoses.resize( numPoses );
+
+	if ( lodLevel == 1 ) {
+		// Skip the blend actions, but lerp all bones.
+		LerpCachedActionPoses( animationLOD.bonePoses.data(), actionIndex, blendActionState );
+		animationLODStatistics.evaluatedBones += numPoses;
+	} else {
+		// (Re-)Gather the bones within reach of the bone depth.
+		const int32_t boneDepth = cl_anim_lod_bonedepth->integer;
+		if ( animationLOD.boneDepth != boneDepth ) {
+			animationLOD.boneIndices.clear();
+			CLG_GatherBoneIndicesToDepth( entitySkeleton.boneTree, 0, boneDepth, animationLOD.boneIndices );
+			animationLOD.boneDepth = boneDepth;
+		}
+
+		// Only lerp those, all others snap to the current frame.
+		clgi.ES_LerpSkeletonPosesForBones( &entitySkeleton,
+										   animationLOD.bonePoses.data(),
+										   animationLOD.boneIndices.data(),
+										   animationLOD.boneIndices.size(),
+										   blendActionState->currentFrame,
+										   blendActionState->oldFrame,
+										   blendActionState->backLerp,
+										   refreshEntity.rootBoneAxisFlags
+		);
+		animationLODStatistics.evaluatedBones += animationLOD.boneIndices.size();
+	}
+
+	animationLOD.lastUpdateFrame = animationLODFrame;
+	refreshEntity.currentBonePoses = animationLOD.bonePoses.data();
+}
+
+/**
+*	@brief	Resets the animation LOD statistics, called before preparing the refresh entities.
+**/
+void CLGBasePacketEntity::BeginAnimationLODFrame() {
+	for ( auto &entities : animationLODStatistics.entities ) {
+		entities = 0;
+	}
+	animationLODStatistics.reusedPoses = 0;
+	animationLODStatistics.evaluatedBones = 0;
+	animationLODFrame++;
+}
+
+/**
+*	@brief	Prints the animation LOD statistics if cl_anim_lod_showstats is set.
+**/
+void CLGBasePacketEntity::EndAnimationLODFrame() {
+	if ( !cl_anim_lod_showstats->integer ) {
+		return;
+	}
+
+	Com_Print( "animlod: %u/%u/%u entities (lod 0/1/2), %u reused poses, %u bones evaluated\n",
+		animationLODStatistics.entities[0].load(), animationLODStatistics.entities[1].load(), animationLODStatistics.entities[2].load(),
+		animationLODStatistics.reusedPoses.load(), animationLODStatistics.evaluatedBones.load() );
+}
+
+/**
+*	@brief	Processes the skeletal animation for the current time, ahead of PrepareRefreshEntity.
+*	@return	True if this entity needs its skeleton poses computed this frame by ComputeDeferredSkeletonPoses.
+**/
+const bool CLGBasePacketEntity::PrepareDeferredSkeletonPoses() {
+	skeletonPosesComputed = false;
+
+	// Same conditions as in PrepareRefreshEntity.
+	if ( !podEntity || !skm || !entitySkeleton.modelPtr ) {
+		return false;
+	}
+	const uint32_t entityEffects = podEntity->currentState.effects;
+	if ( entityEffects & ( EntityEffectType::AnimCycleFrames01hz2 | EntityEffectType::AnimCycleFrames23hz2 
+		| EntityEffectType::AnimCycleAll2hz | EntityEffectType::AnimCycleAll30hz ) ) {
+		return false;
+	}
+
+	// Process the skeletal animation blend action frames for the current client time. (Based on animation start time.)
+	ProcessSkeletalAnimationForTime( GameTime( cl->time ) );
+
+	return true;
+}
+
+/**
+*	@brief	Computes the skeleton poses for the frame, so PrepareRefreshEntity can skip doing so itself.
+**/
+void CLGBasePacketEntity::ComputeDeferredSkeletonPoses() {
+	ComputeEntitySkeletonTransforms( nullptr );
+	skeletonPosesComputed = true;
+}
+
+
 /**
 * 
 (
@@ -1386,8 +1586,10 @@ void CLGBasePacketEntity::PrepareRefreshEntity(const int32_t refreshEntityID, En
 				*	Skeletal Animation Processing.
 				**/
 
-				// Make sure we got model data to work our transformations on.
-				if (entitySkeleton.modelPtr != nullptr ) {
+				// The poses may have been computed in parallel already, see ClientGameEntities::ComputeSkeletonPoses.
+				if ( skeletonPosesComputed ) {
+					skeletonPosesComputed = false;
+				} else if (entitySkeleton.modelPtr != nullptr ) {
 					// Process the skeletal animation blend action frames for the current client time. (Based on animation start time.)
 					ProcessSkeletalAnimationForTime(GameTime(cl->time));
 					// Compute the Entity Skeleton Trasforms for Refresh Frame.
@@ -1412,10 +1614,20 @@ void CLGBasePacketEntity::PrepareRefreshEntity(const int32_t refreshEntityID, En
 		}
 
 
+        //
+        // Fetch the lerped origin, old origin and angles from the interpolation records. These
+        // were set up per render effect when the frame came in, see PacketEntityInterpolation.
+        //
+        vec3_t lerpedOrigin, lerpedOldOrigin, lerpedAngles;
+        const bool hasLerpedTransform = PacketEntityInterpolation::GetLerpedTransform(currentState->number, lerpedOrigin, lerpedOldOrigin, lerpedAngles);
+
         //
         // Setup refreshEntity origin.
         //
-        if (rentRenderEffects& RenderEffects::FrameLerp) {
+        if (hasLerpedTransform && (currentState->number != cl->frame.clientNumber + 1 || (rentRenderEffects & (RenderEffects::FrameLerp | RenderEffects::Beam)))) {
+            refreshEntity.origin = lerpedOrigin;
+            refreshEntity.oldorigin = lerpedOldOrigin;
+        } else if (rentRenderEffects& RenderEffects::FrameLerp) {
             // Step origin discretely, because the model frames do the animation properly.
             refreshEntity.origin = podEntity->currentState.origin;
             refreshEntity.oldorigin = podEntity->currentState.oldOrigin;
@@ -1522,7 +1734,11 @@ void CLGBasePacketEntity::PrepareRefreshEntity(const int32_t refreshEntityID, En
             refreshEntity.angles = cl->playerEntityAngles;
         } else {
             // Otherwise, lerp angles by default.
-            refreshEntity.angles = vec3_mix(podEntity->previousState.angles, podEntity->currentState.angles, cl->lerpFraction);
+            if (hasLerpedTransform) {
+                refreshEntity.angles = lerpedAngles;
+            } else {
+                refreshEntity.angles = vec3_mix(podEntity->previousState.angles, podEntity->currentState.angles, cl->lerpFraction);
+            }
 
             // Mimic original ref_gl "leaning" bug (uuugly!)
             if (currentState->modelIndex == 255 && cl_rollhack->integer) {
@@ -16,6 +16,8 @@
 ***/
 #pragma once
 
+#include <atomic>
+
 // Client Game GameEntity Interface.
 #include "../IClientGameEntity.h"
 
@@ -960,6 +962,20 @@ public:
 protected:
 	//! Actual skeleton unique to this entity.
 	EntitySkeleton entitySkeleton;
+
+	//! True if ComputeDeferredSkeletonPoses already computed the poses for this frame.
+	bool skeletonPosesComputed = false;
+
+	//! Animation LOD state.
+	struct {
+		//! Bone poses kept for reuse in between throttled updates.
+		std::vector<EntitySkeletonBonePose> bonePoses;
+		//! Animation LOD frame of the last pose update, -1 if the poses need updating.
+		int64_t lastUpdateFrame = -1;
+		//! Indices of the bones within reach of boneDepth, lerped at the lowest LOD level.
+		std::vector<int32_t> boneIndices;
+		int32_t boneDepth = -1;
+	} animationLOD;
 	
 	//! Collection of bonePose animation channels.
 	struct {
@@ -1010,6 +1026,62 @@ private:
 	**/
 	virtual void ComputeEntitySkeletonTransforms( EntitySkeletonBonePose *tempBonePoses );
 
+	/**
+	*	@brief	Lerps the action's bone poses for the blend action state into outBonePoses at a
+	*			quantized back lerp, using the skeletal pose cache so distant entities playing the
+	*			same action frames of the same model only compute it once. Reduced animation LOD only.
+	**/
+	void LerpCachedActionPoses( EntitySkeletonBonePose *outBonePoses, const int32_t actionIndex, const EntitySkeletonBlendActionState *blendActionState );
+
+	/**
+	*	@return	The animation LOD level for this entity based on its view distance, scaled by
+	*			the field of view. 0 is full detail, 2 the lowest.
+	**/
+	const int32_t CalculateAnimationLOD();
+	/**
+	*	@brief	Computes the bone poses at a reduced animation LOD level: Blend actions are skipped,
+	*			the poses are only updated every (1 << lodLevel) frames and reused in between. At the
+	*			lowest level only bones up to cl_anim_lod_bonedepth in the bone tree are lerped.
+	**/
+	void ComputeAnimationLODPoses( const int32_t lodLevel, const int32_t actionIndex, const EntitySkeletonBlendActionState *blendActionState );
+
+public:
+	//! Number of animation LOD levels.
+	static constexpr int32_t AnimationLODLevels = 3;
+
+	//! Per frame animation LOD statistics. Atomic since poses are computed on the worker threads.
+	struct AnimationLODStatistics {
+		//! Amount of entities animated at each LOD level.
+		std::atomic<uint32_t> entities[AnimationLODLevels] = {};
+		//! Amount of entities that reused their previous pose.
+		std::atomic<uint32_t> reusedPoses = 0;
+		//! Amount of bones that were lerped, or blended.
+		std::atomic<uint32_t> evaluatedBones = 0;
+	};
+	static AnimationLODStatistics animationLODStatistics;
+	//! Incremented each rendered frame, used for throttling pose updates.
+	static int64_t animationLODFrame;
+
+	/**
+	*	@brief	Resets the animation LOD statistics, called before preparing the refresh entities.
+	**/
+	static void BeginAnimationLODFrame();
+	/**
+	*	@brief	Prints the animation LOD statistics if cl_anim_lod_showstats is set.
+	**/
+	static void EndAnimationLODFrame();
+
+	/**
+	*	@brief	Processes the skeletal animation for the current time, ahead of PrepareRefreshEntity.
+	*	@return	True if this entity needs its skeleton poses computed this frame by ComputeDeferredSkeletonPoses.
+	**/
+	const bool PrepareDeferredSkeletonPoses();
+	/**
+	*	@brief	Computes the skeleton poses for the frame, so PrepareRefreshEntity can skip doing so itself.
+	*			Thread safe with respect to other entities, is called from the pose worker threads.
+	**/
+	void ComputeDeferredSkeletonPoses();
+
 protected:
 	/**
 	*
@@ -0,0 +1,171 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Packet Entity Interpolation Implementation.
+*
+***/
+#include "../ClientGameLocals.h"
+
+#include "PacketEntityInterpolation.h"
+
+//! SSE2 is the baseline on x86-64, other targets use the scalar path.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLG_INTERPOLATION_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define CLG_INTERPOLATION_USE_SSE2 0
+#endif
+
+
+//! The interpolation records.
+PacketEntityInterpolation::InterpolationRecords PacketEntityInterpolation::records = {};
+//! Number of records in use.
+int32_t PacketEntityInterpolation::numRecords = 0;
+//! The server frame that the records were built for, -1 to rebuild.
+int64_t PacketEntityInterpolation::recordsFrameNumber = -1;
+
+
+/**
+*   @brief  Clears all records, and forces them to be rebuilt.
+**/
+void PacketEntityInterpolation::Clear() {
+    for (int32_t i = 0; i < MAX_WIRED_POD_ENTITIES; i++) {
+        records.recordIndices[i] = -1;
+    }
+    numRecords = 0;
+    recordsFrameNumber = -1;
+}
+
+/**
+*   @brief  Forces the records to be rebuilt before the next interpolation. Called when
+*           the client game changed the entity states in between two server frames.
+**/
+void PacketEntityInterpolation::Invalidate() {
+    recordsFrameNumber = -1;
+}
+
+/**
+*   @brief  Builds the records for the packet entities in the current server frame.
+**/
+void PacketEntityInterpolation::BuildRecords() {
+    // Unmap the entities of the previous build.
+    for (int32_t i = 0; i < MAX_WIRED_POD_ENTITIES; i++) {
+        records.recordIndices[i] = -1;
+    }
+    numRecords = 0;
+
+    for (int32_t pointerNumber = 0; pointerNumber < cl->frame.numEntities && numRecords < MaxRecords; pointerNumber++) {
+        const int32_t entityIndex = (cl->frame.firstEntity + pointerNumber) & PARSE_ENTITIES_MASK;
+        const int32_t entityNumber = cl->entityStates[entityIndex].number;
+        if (entityNumber < 0 || entityNumber >= MAX_WIRED_POD_ENTITIES) {
+            continue;
+        }
+
+        const PODEntity *podEntity = &cs->entities[entityNumber];
+        const EntityState &previousState = podEntity->previousState;
+        const EntityState &currentState = podEntity->currentState;
+
+        // Pick the from and to values so that lerping them gives what PrepareRefreshEntity
+        // used to compute for each of the render effects.
+        vec3_t fromOrigin, toOrigin, fromOldOrigin, toOldOrigin;
+        if (currentState.renderEffects & RenderEffects::FrameLerp) {
+            // Step origin discretely, because the model frames do the animation properly.
+            fromOrigin = toOrigin = currentState.origin;
+            fromOldOrigin = toOldOrigin = currentState.oldOrigin;
+        } else if (currentState.renderEffects & RenderEffects::Beam) {
+            // Interpolate start and end points for beams.
+            fromOrigin = previousState.origin;
+            toOrigin = currentState.origin;
+            fromOldOrigin = previousState.oldOrigin;
+            toOldOrigin = currentState.oldOrigin;
+        } else {
+            // The old origin is the lerped origin itself.
+            fromOrigin = fromOldOrigin = previousState.origin;
+            toOrigin = toOldOrigin = currentState.origin;
+        }
+
+        const int32_t recordIndex = numRecords++;
+        records.recordIndices[entityNumber] = recordIndex;
+
+        for (int32_t i = 0; i < 3; i++) {
+            records.from[OriginX + i][recordIndex] = fromOrigin[i];
+            records.delta[OriginX + i][recordIndex] = toOrigin[i] - fromOrigin[i];
+            records.from[OldOriginX + i][recordIndex] = fromOldOrigin[i];
+            records.delta[OldOriginX + i][recordIndex] = toOldOrigin[i] - fromOldOrigin[i];
+            records.from[AngleX + i][recordIndex] = previousState.angles[i];
+            records.delta[AngleX + i][recordIndex] = currentState.angles[i] - previousState.angles[i];
+        }
+    }
+
+    // Zero the padding up to the next multiple of 4, the lerp loop processes it too.
+    for (int32_t recordIndex = numRecords; recordIndex < ((numRecords + 3) & ~3); recordIndex++) {
+        for (int32_t channel = 0; channel < NumberOfChannels; channel++) {
+            records.from[channel][recordIndex] = 0.f;
+            records.delta[channel][recordIndex] = 0.f;
+        }
+    }
+
+    recordsFrameNumber = cl->frame.number;
+}
+
+/**
+*   @brief  Rebuilds the records if a new server frame came in, then lerps all of them
+*           by lerpFraction.
+**/
+void PacketEntityInterpolation::InterpolateEntities(const float lerpFraction) {
+    if (recordsFrameNumber != cl->frame.number) {
+        BuildRecords();
+    }
+
+    // MaxRecords is a multiple of 4, so the last group never reads past the arrays.
+    static_assert(MaxRecords % 4 == 0, "MaxRecords has to be a multiple of 4");
+
+#if CLG_INTERPOLATION_USE_SSE2
+    const __m128 fraction = _mm_set1_ps(lerpFraction);
+
+    for (int32_t channel = 0; channel < NumberOfChannels; channel++) {
+        const float *from = records.from[channel];
+        const float *delta = records.delta[channel];
+        float *lerped = records.lerped[channel];
+
+        for (int32_t i = 0; i < numRecords; i += 4) {
+            // from + delta * fraction.
+            _mm_store_ps(&lerped[i], _mm_add_ps(_mm_load_ps(&from[i]), _mm_mul_ps(_mm_load_ps(&delta[i]), fraction)));
+        }
+    }
+#else
+    for (int32_t channel = 0; channel < NumberOfChannels; channel++) {
+        const float *from = records.from[channel];
+        const float *delta = records.delta[channel];
+        float *lerped = records.lerped[channel];
+
+        for (int32_t i = 0; i < numRecords; i++) {
+            lerped[i] = from[i] + delta[i] * lerpFraction;
+        }
+    }
+#endif
+}
+
+/**
+*   @brief  Fetches the lerped transform of the entity for the current rendered frame.
+*   @return False if the entity has no record in the current server frame.
+**/
+const bool PacketEntityInterpolation::GetLerpedTransform(const int32_t entityNumber, vec3_t &origin, vec3_t &oldOrigin, vec3_t &angles) {
+    if (entityNumber < 0 || entityNumber >= MAX_WIRED_POD_ENTITIES || recordsFrameNumber != cl->frame.number) {
+        return false;
+    }
+
+    const int32_t recordIndex = records.recordIndices[entityNumber];
+    if (recordIndex < 0) {
+        return false;
+    }
+
+    origin = { records.lerped[OriginX][recordIndex], records.lerped[OriginY][recordIndex], records.lerped[OriginZ][recordIndex] };
+    oldOrigin = { records.lerped[OldOriginX][recordIndex], records.lerped[OldOriginY][recordIndex], records.lerped[OldOriginZ][recordIndex] };
+    angles = { records.lerped[AngleX][recordIndex], records.lerped[AngleY][recordIndex], records.lerped[AngleZ][recordIndex] };
+
+    return true;
+}
@@ -0,0 +1,81 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Packet Entity Interpolation: The interpolation inputs (previous and current origin, old
+*	origin, and angles) of all packet entities in the current server frame, stored as
+*	structure of arrays records. They are built once per received frame, after which every
+*	rendered frame lerps all of them in a single loop, 4 values at a time.
+*
+*	CLGBasePacketEntity::PrepareRefreshEntity picks up the lerped transform from here
+*	instead of computing it itself.
+*
+***/
+#pragma once
+
+
+
+/**
+*   @brief  Per server frame interpolation records of the packet entities.
+**/
+class PacketEntityInterpolation {
+public:
+    /**
+    *   @brief  Clears all records, and forces them to be rebuilt.
+    **/
+    static void Clear();
+
+    /**
+    *   @brief  Forces the records to be rebuilt before the next interpolation. Called when
+    *           the client game changed the entity states in between two server frames.
+    **/
+    static void Invalidate();
+
+    /**
+    *   @brief  Rebuilds the records if a new server frame came in, then lerps all of them
+    *           by lerpFraction.
+    **/
+    static void InterpolateEntities(const float lerpFraction);
+
+    /**
+    *   @brief  Fetches the lerped transform of the entity for the current rendered frame.
+    *   @return False if the entity has no record in the current server frame.
+    **/
+    static const bool GetLerpedTransform(const int32_t entityNumber, vec3_t &origin, vec3_t &oldOrigin, vec3_t &angles);
+
+private:
+    /**
+    *   @brief  Builds the records for the packet entities in the current server frame.
+    **/
+    static void BuildRecords();
+
+    //! Maximum amount of records, rounded up to a multiple of 4 for the lerp loop.
+    static constexpr int32_t MaxRecords = ( MAX_WIRED_POD_ENTITIES + 3 ) & ~3;
+
+    //! Lerped channels: origin, old origin, and angles.
+    enum Channel : int32_t {
+        OriginX, OriginY, OriginZ,
+        OldOriginX, OldOriginY, OldOriginZ,
+        AngleX, AngleY, AngleZ,
+        NumberOfChannels
+    };
+
+    struct InterpolationRecords {
+        //! The previous frame's values, and the difference towards the current frame's values.
+        alignas(16) float from[NumberOfChannels][MaxRecords];
+        alignas(16) float delta[NumberOfChannels][MaxRecords];
+        //! The lerped values for the rendered frame, written by InterpolateEntities.
+        alignas(16) float lerped[NumberOfChannels][MaxRecords];
+
+        //! Record index for each packet entity number, -1 if it has none.
+        int32_t recordIndices[MAX_WIRED_POD_ENTITIES];
+    };
+    //! The interpolation records.
+    static InterpolationRecords records;
+    //! Number of records in use.
+    static int32_t numRecords;
+    //! The server frame that the records were built for, -1 to rebuild.
+    static int64_t recordsFrameNumber;
+};
@@ -0,0 +1,78 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Skeletal Pose Cache: Shares the lerped bone poses of distant skeletal entities that play
+*	the same action frames of the same model.
+*
+***/
+#include "../ClientGameLocals.h"
+
+#include "SkeletalPoseCache.h"
+
+
+
+//! The stripes.
+SkeletalPoseCache::Stripe SkeletalPoseCache::stripes[SkeletalPoseCache::NumberOfStripes];
+
+/**
+*	@return	The hash of the key, picks the stripe, and the slot within it.
+**/
+const uint32_t SkeletalPoseCache::HashKey( const SkeletalPoseCacheKey &key ) {
+	uint32_t hash = 2166136261U;
+	const int32_t values[] = { key.modelHandle, key.actionIndex, key.frame, key.oldFrame, key.lerpBucket, key.rootBoneAxisFlags };
+	for ( const int32_t value : values ) {
+		hash = ( hash ^ (uint32_t)value ) * 16777619U;
+	}
+	return hash;
+}
+
+/**
+*	@brief	Copies the cached poses for key into outBonePoses.
+*	@return	False on a miss.
+**/
+const bool SkeletalPoseCache::Find( const SkeletalPoseCacheKey &key, EntitySkeletonBonePose *outBonePoses, const uint32_t numPoses ) {
+	const uint32_t hash = HashKey( key );
+	Stripe &stripe = stripes[hash % NumberOfStripes];
+	const Slot &slot = stripe.slots[( hash / NumberOfStripes ) % SlotsPerStripe];
+
+	std::lock_guard<std::mutex> lock( stripe.mutex );
+	if ( slot.numPoses != numPoses || !( slot.key == key ) ) {
+		return false;
+	}
+
+	memcpy( outBonePoses, slot.bonePoses, sizeof( EntitySkeletonBonePose ) * numPoses );
+	return true;
+}
+
+/**
+*	@brief	Stores the poses for key in its slot, replacing whatever was in there.
+**/
+void SkeletalPoseCache::Store( const SkeletalPoseCacheKey &key, const EntitySkeletonBonePose *bonePoses, const uint32_t numPoses ) {
+	if ( !numPoses || numPoses > IQM_MAX_JOINTS ) {
+		return;
+	}
+
+	const uint32_t hash = HashKey( key );
+	Stripe &stripe = stripes[hash % NumberOfStripes];
+	Slot &slot = stripe.slots[( hash / NumberOfStripes ) % SlotsPerStripe];
+
+	std::lock_guard<std::mutex> lock( stripe.mutex );
+	slot.key = key;
+	slot.numPoses = numPoses;
+	memcpy( slot.bonePoses, bonePoses, sizeof( EntitySkeletonBonePose ) * numPoses );
+}
+
+/**
+*	@brief	Empties all slots.
+**/
+void SkeletalPoseCache::Clear() {
+	for ( Stripe &stripe : stripes ) {
+		std::lock_guard<std::mutex> lock( stripe.mutex );
+		for ( Slot &slot : stripe.slots ) {
+			slot.numPoses = 0;
+		}
+	}
+}
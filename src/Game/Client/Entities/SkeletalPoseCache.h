@@ -0,0 +1,102 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Skeletal Pose Cache: Shares the lerped bone poses of distant skeletal entities that play
+*	the same action frames of the same model. Their back lerp is quantized so that entities
+*	a fraction of a frame apart still share the pose. Full detail entities don't use it.
+*
+*	The cache has a fixed number of preallocated slots, a key maps to exactly one of them and
+*	a miss simply overwrites it. The slots are divided into stripes with a lock each, so the
+*	pose workers only contend when they touch the same stripe.
+*
+***/
+#pragma once
+
+#include <mutex>
+
+
+
+/**
+*	@brief	Look-up key for a cached pose: (model, action, frame, quantized lerp).
+**/
+struct SkeletalPoseCacheKey {
+	//! Model handle the pose belongs to.
+	qhandle_t modelHandle = 0;
+	//! Action index within the model's skeletal model data.
+	int32_t actionIndex = 0;
+	//! Current, and old frame of the pose.
+	int32_t frame = 0;
+	int32_t oldFrame = 0;
+	//! Quantized back lerp, see SkeletalPoseCache::QuantizeLerp.
+	int32_t lerpBucket = 0;
+	//! Root bone axis flags the pose was computed with.
+	int32_t rootBoneAxisFlags = 0;
+
+	bool operator==( const SkeletalPoseCacheKey &other ) const = default;
+};
+
+/**
+*	@brief	Fixed size, lock striped cache of lerped skeletal poses.
+**/
+class SkeletalPoseCache {
+public:
+	//! Number of buckets the [0, 1] lerp range is quantized into.
+	static constexpr int32_t LerpBuckets = 32;
+
+	/**
+	*	@return	The bucket for the given lerp fraction.
+	**/
+	static inline const int32_t QuantizeLerp( const float lerp ) {
+		return (int32_t)( Clampf( lerp, 0.f, 1.f ) * LerpBuckets + 0.5f );
+	}
+	/**
+	*	@return	The lerp fraction for the given bucket.
+	**/
+	static inline const float DequantizeLerp( const int32_t lerpBucket ) {
+		return (float)lerpBucket / LerpBuckets;
+	}
+
+	/**
+	*	@brief	Copies the cached poses for key into outBonePoses.
+	*	@return	False on a miss.
+	**/
+	static const bool Find( const SkeletalPoseCacheKey &key, EntitySkeletonBonePose *outBonePoses, const uint32_t numPoses );
+	/**
+	*	@brief	Stores the poses for key in its slot, replacing whatever was in there.
+	**/
+	static void Store( const SkeletalPoseCacheKey &key, const EntitySkeletonBonePose *bonePoses, const uint32_t numPoses );
+	/**
+	*	@brief	Empties all slots. Model handles are reassigned per map, so this is called on
+	*			a map change.
+	**/
+	static void Clear();
+
+private:
+	//! Number of stripes, and the number of slots in each of them.
+	static constexpr int32_t NumberOfStripes = 8;
+	static constexpr int32_t SlotsPerStripe = 16;
+
+	struct Slot {
+		//! Key of the poses in this slot.
+		SkeletalPoseCacheKey key;
+		//! Number of poses in this slot, 0 if it is empty.
+		uint32_t numPoses = 0;
+		//! The lerped poses.
+		EntitySkeletonBonePose bonePoses[IQM_MAX_JOINTS];
+	};
+	struct Stripe {
+		//! Guards the slots of this stripe.
+		std::mutex mutex;
+		Slot slots[SlotsPerStripe];
+	};
+	//! The stripes.
+	static Stripe stripes[NumberOfStripes];
+
+	/**
+	*	@return	The hash of the key, picks the stripe, and the slot within it.
+	**/
+	static const uint32_t HashKey( const SkeletalPoseCacheKey &key );
+};
@@ -16,6 +16,7 @@
 #include "Movement.h"
 
 #include "../Effects/Particles.h"
+#include "../Utilities/CLGParallelFor.h"
 
 
 /**
@@ -145,6 +146,8 @@ void ClientGameCore::Initialize() {
     cl_noskins = clgi.Cvar_Get("cl_noskins", "0", 0);
     cl_noskins->changed = cl_noskins_changed;
     cl_predict = clgi.Cvar_Get("cl_predict", NULL, 0);
+    cl_predict_cache = clgi.Cvar_Get("cl_predict_cache", "1", 0);
+    cl_predict_showstats = clgi.Cvar_Get("cl_predict_showstats", "0", 0);
     cl_rollhack = clgi.Cvar_Get("cl_rollhack", NULL, 0);
     sv_paused = clgi.Cvar_Get("sv_paused", NULL, 0);
 
@@ -171,6 +174,13 @@ void ClientGameCore::Initialize() {
     cl_vwep = clgi.Cvar_Get("cl_vwep", "1", CVAR_ARCHIVE);
     cl_vwep->changed = cl_vwep_changed;
 
+    cl_anim_lod = clgi.Cvar_Get("cl_anim_lod", "1", 0);
+    cl_anim_lod_distance1 = clgi.Cvar_Get("cl_anim_lod_distance1", "512", 0);
+    cl_anim_lod_distance2 = clgi.Cvar_Get("cl_anim_lod_distance2", "1024", 0);
+    cl_anim_lod_bonedepth = clgi.Cvar_Get("cl_anim_lod_bonedepth", "3", 0);
+    cl_anim_lod_showstats = clgi.Cvar_Get("cl_anim_lod_showstats", "0", 0);
+    cl_anim_parallel = clgi.Cvar_Get("cl_anim_parallel", "1", 0);
+
     //
     // User Info.
     //
@@ -216,4 +226,7 @@ void ClientGameCore::Initialize() {
 **/
 void ClientGameCore::Shutdown() {
     clgi.Cmd_Unregister(cmd_cgmodule);
+
+    // Join the pose worker threads before the module is unloaded.
+    CLG_ShutdownParallelFor();
 }
\ No newline at end of file
@@ -24,6 +24,10 @@
 // Entitiess.
 #include "../Entities/Base/CLGBasePacketEntity.h"
 #include "../Entities/Base/CLGBaseLocalEntity.h"
+#include "../Entities/PacketEntityInterpolation.h"
+
+// Parallel For.
+#include "../Utilities/CLGParallelFor.h"
 
 // World.
 #include "../World/ClientGameWorld.h"
@@ -238,6 +242,9 @@ void ClientGameEntities::RunPacketEntitiesDeltaFrame() {
 		SGEntityHandle handle = podEntity;
 		SG_RunEntity(handle);
     }
+
+	// The entities may have moved, have their interpolation records rebuilt.
+	PacketEntityInterpolation::Invalidate();
 }
 
 /**
@@ -426,6 +433,15 @@ void ClientGameEntities::PrepareRefreshEntities() {
 	// Get Gameworld, we're about to iterate.
 	ClientGameWorld *gameWorld = GetGameWorld();
 
+	// Reset the animation LOD statistics for this frame.
+	CLGBasePacketEntity::BeginAnimationLODFrame();
+
+	// Compute the skeleton poses of all skeletal entities up front, in parallel.
+	ComputeSkeletonPoses();
+
+	// Lerp the origins and angles of all packet entities in one go.
+	PacketEntityInterpolation::InterpolateEntities(cl->lerpFraction);
+
     // Iterate from 0 till the amount of entities present in the current frame.
     for (int32_t pointerNumber = 0; pointerNumber < cl->frame.numEntities; pointerNumber++) {
         // Get the entity state index.
@@ -476,6 +492,52 @@ void ClientGameEntities::PrepareRefreshEntities() {
 		// Go on.
 		gameEntity->PrepareRefreshEntity(refreshEntityID, entityState, previousEntityState, cl->lerpFraction);
     }
+
+	// Print the animation LOD statistics if requested.
+	CLGBasePacketEntity::EndAnimationLODFrame();
+}
+
+/**
+*	@brief	Parallel for callback, computes the skeleton poses for a single entity.
+**/
+static void CLG_ComputeDeferredSkeletonPoses( const int32_t index, void *userData ) {
+	CLGBasePacketEntity **entities = static_cast<CLGBasePacketEntity**>( userData );
+	entities[index]->ComputeDeferredSkeletonPoses();
+}
+
+/**
+*	@brief	Computes the skeleton poses of all skeletal packet entities in the current frame in
+*			parallel, PrepareRefreshEntity then picks up their poses instead of computing them itself.
+**/
+void ClientGameEntities::ComputeSkeletonPoses() {
+	if ( !cl_anim_parallel->integer ) {
+		return;
+	}
+
+	// Get Gameworld, we're about to iterate.
+	ClientGameWorld *gameWorld = GetGameWorld();
+
+	// Gather the entities that need their poses computed, processing their animation
+	// time on this thread first.
+	static CLGBasePacketEntity *skeletalEntities[MAX_PACKET_ENTITIES];
+	int32_t numSkeletalEntities = 0;
+
+	for ( int32_t pointerNumber = 0; pointerNumber < cl->frame.numEntities && numSkeletalEntities < MAX_PACKET_ENTITIES; pointerNumber++ ) {
+        const int32_t entityIndex = (cl->frame.firstEntity + pointerNumber) & PARSE_ENTITIES_MASK;
+        PODEntity *clientEntity = &cs->entities[ cl->entityStates[entityIndex].number ];
+        GameEntity *gameEntity = gameWorld->GetGameEntityByIndex(clientEntity->clientEntityNumber);
+
+		if ( !gameEntity || !gameEntity->IsSubclassOf<CLGBasePacketEntity>() ) {
+			continue;
+		}
+
+		CLGBasePacketEntity *packetEntity = static_cast<CLGBasePacketEntity*>( gameEntity );
+		if ( packetEntity->PrepareDeferredSkeletonPoses() ) {
+			skeletalEntities[numSkeletalEntities++] = packetEntity;
+		}
+	}
+
+	CLG_ParallelFor( numSkeletalEntities, CLG_ComputeDeferredSkeletonPoses, skeletalEntities );
 }
 
 /**
@@ -117,5 +117,11 @@ private:
 	*   @brief  Gives the opportunity to adjust render effects where desired.
     **/
 	int32_t ApplyRenderEffects(int32_t renderEffects);
+
+	/**
+	*   @brief  Computes the skeleton poses of all skeletal packet entities of the current frame in
+	*			parallel, before PrepareRefreshEntities submits them.
+	**/
+	void ComputeSkeletonPoses();
 };
 
@@ -11,6 +11,15 @@
 // Distance that is allowed to be taken as a delta before we reset it.
 static const double MAX_DELTA_ORIGIN = (2400.0 * (1.00 / BASE_FRAMERATE));
 
+/**
+*   @return True if both player move inputs are identical.
+**/
+static inline const bool CLG_PlayerMoveInputsEqual(const PlayerMoveInput &a, const PlayerMoveInput &b) {
+    return a.msec == b.msec && vec3_equal(a.viewAngles, b.viewAngles) &&
+        a.forwardMove == b.forwardMove && a.rightMove == b.rightMove && a.upMove == b.upMove &&
+        a.buttons == b.buttons && a.impulse == b.impulse && a.lightLevel == b.lightLevel;
+}
+
 
 //--------------------------------------------------------
 // Test code.
@@ -92,6 +101,13 @@ void ClientGamePrediction::PredictMovement(uint32_t acknowledgedCommandIndex, ui
 #if USE_SMOOTH_DELTA_ANGLES
     pm.state.deltaAngles = clge->view->GetViewCamera()->GetViewDeltaAngles(); //cl->deltaAngles;
 #endif
+
+    // Skip the commands whose predicted results are still valid.
+    const uint32_t lastCommandIndex = currentCommandIndex;
+    const uint32_t firstCommandIndex = acknowledgedCommandIndex;
+    acknowledgedCommandIndex = ResumeFromPredictionCache(pm, acknowledgedCommandIndex, currentCommandIndex);
+    predictionStatistics.cachedCommands = acknowledgedCommandIndex - firstCommandIndex;
+    predictionStatistics.simulatedCommands = 0;
 	
     // Run frames in order.
     while (++acknowledgedCommandIndex <= currentCommandIndex) {
@@ -109,6 +125,7 @@ void ClientGamePrediction::PredictMovement(uint32_t acknowledgedCommandIndex, ui
 						
             // Simulate the move command.
             PMove(&pm);
+            predictionStatistics.simulatedCommands++;
 
             // Update player move client side audio effects.
             UpdateClientSoundSpecialEffects(&pm);
@@ -125,6 +142,9 @@ void ClientGamePrediction::PredictMovement(uint32_t acknowledgedCommandIndex, ui
         // Save for error detection
         cmd->prediction.origin = pm.state.origin;
 
+        // Cache the result, so the next frame can resume from here.
+        StorePredictedCommand(acknowledgedCommandIndex, *cmd, pm);
+
 		// Get Game World.
 		//ClientGameWorld *gameWorld = GetGameWorld();
 		//auto *playerEntity = gameWorld->GetClientGameEntity();
@@ -143,6 +163,7 @@ void ClientGamePrediction::PredictMovement(uint32_t acknowledgedCommandIndex, ui
         pm.moveCommand.input.rightMove = cl->localMove[1];
         pm.moveCommand.input.upMove = cl->localMove[2];
         PMove(&pm);
+        predictionStatistics.simulatedCommands++;
 		
         // Update player move client side audio effects.
         UpdateClientSoundSpecialEffects(&pm);
@@ -174,6 +195,86 @@ void ClientGamePrediction::PredictMovement(uint32_t acknowledgedCommandIndex, ui
     cl->predictedState.viewAngles = pm.viewAngles;
 
     cl->predictedState.groundEntityNumber = pm.groundEntityNumber; //	cl->predictedState.groundEntityPtr = pm.groundEntityPtr;
+
+    PrintPredictionStatistics(firstCommandIndex, lastCommandIndex);
+}
+
+/**
+*   @brief  Invalidates all cached predicted player moves. Called when the client state is cleared.
+**/
+void ClientGamePrediction::ClearPredictionCache() {
+    for (PredictedCommand &predictedCommand : predictedCommands) {
+        predictedCommand.valid = false;
+    }
+
+    predictionBase.serverFrameNumber = -1;
+    predictionBase.acknowledgedCommandIndex = 0;
+    predictionBase.deltaAngles = vec3_zero();
+}
+
+/**
+*   @brief  Restores the player move of the last command in (acknowledgedCommandIndex, currentCommandIndex]
+*           whose cached result is still valid, into pm.
+*   @return The index of that command, or acknowledgedCommandIndex if no cached result could be used.
+**/
+uint32_t ClientGamePrediction::ResumeFromPredictionCache(PlayerMove &pm, uint32_t acknowledgedCommandIndex, uint32_t currentCommandIndex) {
+    // Results are only valid for the state they were predicted from. A new server frame
+    // brings a new authoritative player state, and moves the entities we collide with.
+    if (!cl_predict_cache->integer
+        || predictionBase.serverFrameNumber != cl->frame.number
+        || predictionBase.acknowledgedCommandIndex != acknowledgedCommandIndex
+        || !vec3_equal(predictionBase.deltaAngles, pm.state.deltaAngles)) {
+        ClearPredictionCache();
+
+        predictionBase.serverFrameNumber = cl->frame.number;
+        predictionBase.acknowledgedCommandIndex = acknowledgedCommandIndex;
+        predictionBase.deltaAngles = pm.state.deltaAngles;
+        return acknowledgedCommandIndex;
+    }
+
+    // Walk the commands until we find one that has no result yet, or had its input changed.
+    uint32_t commandIndex = acknowledgedCommandIndex;
+    while (commandIndex + 1 <= currentCommandIndex) {
+        const ClientMoveCommand &moveCommand = cl->clientUserCommands[(commandIndex + 1) & CMD_MASK];
+        const PredictedCommand &predictedCommand = predictedCommands[(commandIndex + 1) & CMD_MASK];
+
+        if (!predictedCommand.valid || predictedCommand.commandNumber != commandIndex + 1
+            || !CLG_PlayerMoveInputsEqual(predictedCommand.input, moveCommand.input)) {
+            break;
+        }
+
+        commandIndex++;
+    }
+
+    // Restore the player move of the last valid command.
+    if (commandIndex != acknowledgedCommandIndex) {
+        pm = predictedCommands[commandIndex & CMD_MASK].playerMove;
+    }
+
+    return commandIndex;
+}
+
+/**
+*   @brief  Stores the result of simulating the command at commandIndex in the prediction cache.
+**/
+void ClientGamePrediction::StorePredictedCommand(uint32_t commandIndex, const ClientMoveCommand &moveCommand, const PlayerMove &pm) {
+    PredictedCommand &predictedCommand = predictedCommands[commandIndex & CMD_MASK];
+    predictedCommand.commandNumber = commandIndex;
+    predictedCommand.input = moveCommand.input;
+    predictedCommand.playerMove = pm;
+    predictedCommand.valid = true;
+}
+
+/**
+*   @brief  Prints the prediction statistics if cl_predict_showstats is set.
+**/
+void ClientGamePrediction::PrintPredictionStatistics(uint32_t acknowledgedCommandIndex, uint32_t currentCommandIndex) {
+    if (!cl_predict_showstats->integer) {
+        return;
+    }
+
+    Com_Print("predict: %u commands simulated, %u cached, %u unacknowledged\n",
+        predictionStatistics.simulatedCommands, predictionStatistics.cachedCommands, currentCommandIndex - acknowledgedCommandIndex);
 }
 
 /**
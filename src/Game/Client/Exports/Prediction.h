@@ -38,7 +38,58 @@ public:
     **/
     void UpdateClientSoundSpecialEffects(PlayerMove* pm) final;
 
+    /**
+    *   @brief  Invalidates all cached predicted player moves. Called when the client state is cleared.
+    **/
+    void ClearPredictionCache();
+
 private:
+    /**
+    *   @brief  Restores the player move of the last command in (acknowledgedCommandIndex, currentCommandIndex]
+    *           whose cached result is still valid, into pm.
+    *   @return The index of that command, or acknowledgedCommandIndex if no cached result could be used.
+    **/
+    uint32_t ResumeFromPredictionCache(PlayerMove &pm, uint32_t acknowledgedCommandIndex, uint32_t currentCommandIndex);
+    /**
+    *   @brief  Stores the result of simulating the command at commandIndex in the prediction cache.
+    **/
+    void StorePredictedCommand(uint32_t commandIndex, const ClientMoveCommand &moveCommand, const PlayerMove &pm);
+    /**
+    *   @brief  Prints the prediction statistics if cl_predict_showstats is set.
+    **/
+    void PrintPredictionStatistics(uint32_t acknowledgedCommandIndex, uint32_t currentCommandIndex);
+
+    //! A predicted player move, valid as long as both the command's input, and the state
+    //! prediction started from remain unchanged.
+    struct PredictedCommand {
+        //! Number of the command this result belongs to.
+        uint32_t commandNumber = 0;
+        //! The input it was simulated with.
+        PlayerMoveInput input = {};
+        //! The resulting player move.
+        PlayerMove playerMove = {};
+        //! False if this slot holds no result.
+        bool valid = false;
+    };
+    //! Predicted player moves, indexed by command number & CMD_MASK.
+    PredictedCommand predictedCommands[CMD_BACKUP];
+
+    //! The state the cached player moves were predicted from.
+    struct {
+        //! Server frame the authoritative player state came from.
+        int32_t serverFrameNumber = -1;
+        //! Acknowledged command index.
+        uint32_t acknowledgedCommandIndex = 0;
+        //! Delta angles that the player move state started with.
+        vec3_t deltaAngles = vec3_zero();
+    } predictionBase;
+
+    //! Number of commands simulated, and reused from the cache during the last PredictMovement.
+    struct {
+        uint32_t simulatedCommands = 0;
+        uint32_t cachedCommands = 0;
+    } predictionStatistics;
+
 	/**
 	*	@brief	Dispatch touch callbacks for all predicted touched entities.
 	**/
@@ -39,6 +39,7 @@ void ClientGameView::PreRenderView() {
 **/
 void ClientGameView::ClearScene() {
     num_dlights = 0;
+    viewLights.Clear();
     num_renderEntities = 0;
     num_particles = 0;
 }
@@ -73,6 +74,12 @@ void ClientGameView::RenderView() {
     cl->refdef.vieworg      = viewCamera.GetViewOrigin();
     cl->refdef.viewAngles   = viewCamera.GetViewAngles();
 
+    // Pick the lights that fit the budget of the renderer in use. The fov is that of
+    // the previous frame, the engine calculates it after we return.
+    const int32_t dlightBudget = (vid_rtx && vid_rtx->integer ? cl_dlight_budget_rtx->integer : cl_dlight_budget->integer);
+    num_dlights = viewLights.SubmitLights(cl->refdef.vieworg, cl->refdef.viewAngles, cl->refdef.fov_x, cl->refdef.fov_y,
+                                          dlights, dlightBudget, cl_dlight_merge_distance->value, cl_dlight_cull->integer != 0);
+
     // Last but not least, pass our array over to the client.
     cl->refdef.num_entities = num_renderEntities;
     cl->refdef.entities = renderEntities;
@@ -233,6 +240,11 @@ void ClientGameView::Initialize() {
 
     cl_adjustfov        = clgi.Cvar_Get("cl_adjustfov", "1", 0);
 
+    cl_dlight_budget        = clgi.Cvar_Get("cl_dlight_budget", "32", 0);
+    cl_dlight_budget_rtx    = clgi.Cvar_Get("cl_dlight_budget_rtx", "64", 0);
+    cl_dlight_merge_distance= clgi.Cvar_Get("cl_dlight_merge_distance", "24", 0);
+    cl_dlight_cull          = clgi.Cvar_Get("cl_dlight_cull", "1", 0);
+
     clgi.Cmd_AddMacro("cl_viewpos", CL_ViewPos_m);
 	clgi.Cmd_AddMacro("cl_viewdir", CL_ViewDir_m);
 
@@ -284,28 +296,19 @@ bool ClientGameView::AddRenderParticle(const rparticle_t &renderParticle) {
 *           the old AddLight/AddLightEx with a single function.
 **/
 void ClientGameView::AddLight(const vec3_t& origin, const vec3_t &rgb, float intensity, float radius) {
-    // We topped the dynamic light limit, developer print a warning and opt out.
-    if (num_dlights >= MAX_DLIGHTS) {
-        Com_DPrint("Warning: client view num_dlights >= MAX_DLIGHTS\n");
+    // We topped the light candidate limit, developer print a warning and opt out.
+    if (!viewLights.AddLight(origin, rgb, intensity, radius)) {
+        Com_DPrint("Warning: client view light candidates >= ViewLights::MaxCandidates\n");
         return;
     }
 
-    // Acquire a reference to the free dynamic light slot.
-    rdlight_t &dynamicLight = dlights[num_dlights++];
-    dynamicLight.origin     = origin;
-    dynamicLight.intensity  = intensity;
-    dynamicLight.color.x    = rgb.x;
-    dynamicLight.color.y    = rgb.y;
-    dynamicLight.color.z    = rgb.z;
-	dynamicLight.radius     = radius;
-
     // For developer/debug reasons, add a particle to where a light is meant to be just in case
     // something is off. Helps visualizing dat sh1t3 y0 d4wg.
 	if (cl_show_lights->integer && num_particles < MAX_PARTICLES)
 	{
 		rparticle_t &particle = particles[num_particles++];
 
-		particle.origin = dynamicLight.origin;
+		particle.origin = origin;
 		particle.radius = radius;
 		particle.brightness = Maxf(rgb.x, Maxf(rgb.y, rgb.z));
 		particle.color = -1;
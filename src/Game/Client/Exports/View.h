@@ -11,6 +11,8 @@
 
 // View Camera.
 #include "../View/ViewCamera.h"
+// View Lights.
+#include "../View/ViewLights.h"
 
 
 /**
@@ -76,7 +78,8 @@ public:
     bool AddRenderParticle(const rparticle_t &renderParticle);
 
     /**
-    *   @brief  Adds a light to the current frame view.
+    *   @brief  Adds a light to the current frame view. It is only a candidate until
+    *           RenderView culls, merges and ranks all lights to fit the light budget.
     *   @param  radius defaults to 10.f, effectively replacing 
     *           the old AddLight/AddLightEx with a single function.
     **/
@@ -102,6 +105,9 @@ private:
     //! Client's main view camera tracking the player position and angles.
     ViewCamera viewCamera;
 
+    //! Gathers the frame's lights, and picks those that are handed to the refresh.
+    ViewLights viewLights;
+
 
     /**
     *   @brief  Finalizes the view values, aka render first or third person specific view data.
@@ -135,6 +141,11 @@ private:
     cvar_t *cl_add_blend    = nullptr;
     cvar_t *cl_adjustfov    = nullptr;
 
+    cvar_t *cl_dlight_budget        = nullptr;  // Maximum number of dynamic lights handed to the GL refresh.
+    cvar_t *cl_dlight_budget_rtx    = nullptr;  // Maximum number of dynamic lights handed to the vkpt refresh.
+    cvar_t *cl_dlight_merge_distance= nullptr;  // Lights closer to each other than this are merged into one, 0 disables.
+    cvar_t *cl_dlight_cull          = nullptr;  // Culls lights against the view frustum and PVS.
+
 
 
 private:
@@ -142,7 +153,7 @@ private:
     r_entity_t renderEntities[MAX_ENTITIES];
     int32_t num_renderEntities;
 
-    //! Holds all the dynamic lights currently in the view frame.
+    //! Holds the dynamic lights that were picked by viewLights for the view frame.
     rdlight_t dlights[MAX_DLIGHTS];
     int32_t num_dlights;
 
@@ -22,6 +22,9 @@
 // ClientGameWorld.
 #include "World/ClientGameWorld.h"
 
+// Pools.
+#include "Utilities/CLGPool.h"
+
 //
 // CVars.
 //
@@ -105,7 +108,7 @@ static void cl_railspiral_color_changed(cvar_t* self)
 //=============================================================================
 //
 
-#define MAX_LASERS  32
+#define MAX_LASERS  128
 
 typedef struct {
 	vec3_t      start;
@@ -116,27 +119,23 @@ typedef struct {
 	int         lifetime, starttime;
 } laser_t;
 
-static laser_t  clg_lasers[MAX_LASERS];
+static CLGPool<laser_t, MAX_LASERS> clg_lasers;
 
 static void CLG_ClearLasers(void)
 {
-	memset(clg_lasers, 0, sizeof(clg_lasers));
+	clg_lasers.Clear();
 }
 
 static laser_t* CLG_AllocLaser(void)
 {
 	laser_t* l;
-	int i;
 
-	for (i = 0, l = clg_lasers; i < MAX_LASERS; i++, l++) {
-		if (cl->time - l->starttime >= l->lifetime) {
-			memset(l, 0, sizeof(*l));
-			l->starttime = cl->time;
-			return l;
-		}
-	}
+	l = clg_lasers.Alloc();
+	if (!l)
+		return NULL;
 
-	return NULL;
+	l->starttime = cl->time;
+	return l;
 }
 
 static void CLG_AddLasers(void)
@@ -148,9 +147,12 @@ static void CLG_AddLasers(void)
 
 	memset(&ent, 0, sizeof(ent));
 
-	for (i = 0, l = clg_lasers; i < MAX_LASERS; i++, l++) {
+	for (i = clg_lasers.GetNumberOfActive() - 1; i >= 0; i--) {
+		l = clg_lasers.GetActive(i);
+
 		time = l->lifetime - (cl->time - l->starttime);
 		if (time < 0) {
+			clg_lasers.Free(l);
 			continue;
 		}
 
@@ -200,37 +202,36 @@ static void CLG_ParseLaser(int colors)
 //
 //=============================================================================
 //
-explosion_t  clg_explosions[MAX_EXPLOSIONS];
+static CLGPool<explosion_t, MAX_EXPLOSIONS> clg_explosions;
 
 static void CLG_ClearExplosions(void)
 {
-	memset(clg_explosions, 0, sizeof(clg_explosions));
+	clg_explosions.Clear();
 }
 
 static explosion_t* CLG_AllocExplosion(void)
 {
 	explosion_t* e, * oldest;
 	int     i;
-	int     time;
+	float   time;
 
-	for (i = 0, e = clg_explosions; i < MAX_EXPLOSIONS; i++, e++) {
-		if (e->type == explosion_t::ex_free) { // CPP: Enum
-			memset(e, 0, sizeof(*e));
-			return e;
-		}
+	if (!clg_explosions.IsFull()) {
+		return clg_explosions.Alloc();
 	}
+
 	// find the oldest explosion
 	time = cl->time;
-	oldest = clg_explosions;
+	oldest = clg_explosions.GetActive(0);
 
-	for (i = 0, e = clg_explosions; i < MAX_EXPLOSIONS; i++, e++) {
+	for (i = 0; i < clg_explosions.GetNumberOfActive(); i++) {
+		e = clg_explosions.GetActive(i);
 		if (e->start < time) {
 			time = e->start;
 			oldest = e;
 		}
 	}
-	memset(oldest, 0, sizeof(*oldest));
-	return oldest;
+	clg_explosions.Free(oldest);
+	return clg_explosions.Alloc();
 }
 
 static explosion_t* CLG_PlainExplosion(qboolean big, const vec3_t &origin) {
@@ -378,9 +379,8 @@ static void CLG_AddExplosions(void)
 
 	memset(&ent, 0, sizeof(ent));
 
-	for (i = 0, ex = clg_explosions; i < MAX_EXPLOSIONS; i++, ex++) {
-		if (ex->type == explosion_t::ex_free) // CPP: Cast
-			continue;
+	for (i = clg_explosions.GetNumberOfActive() - 1; i >= 0; i--) {
+		ex = clg_explosions.GetActive(i);
 		float inv_frametime = ex->frameTime ? 1.f / (float)ex->frameTime : BASE_1_FRAMETIME;
 		frac = (cl->time - ex->start) * inv_frametime;
 		f = floor(frac);
@@ -450,6 +450,7 @@ static void CLG_AddExplosions(void)
 		}
 
 		if (ex->type == explosion_t::ex_free) {
+			clg_explosions.Free(ex);
 			continue;
 		}
 
@@ -483,7 +484,7 @@ static void CLG_AddExplosions(void)
 //=============================================================================
 //
 
-#define MAX_BEAMS   32
+#define MAX_BEAMS   128
 
 typedef struct {
 	int         entity;
@@ -494,13 +495,13 @@ typedef struct {
 	vec3_t      start, end;
 } beam_t;
 
-static beam_t   clg_beams[MAX_BEAMS];
-static beam_t   clg_playerbeams[MAX_BEAMS];
+static CLGPool<beam_t, MAX_BEAMS> clg_beams;
+static CLGPool<beam_t, MAX_BEAMS> clg_playerbeams;
 
 static void CLG_ClearBeams(void)
 {
-	memset(clg_beams, 0, sizeof(clg_beams));
-	memset(clg_playerbeams, 0, sizeof(clg_playerbeams));
+	clg_beams.Clear();
+	clg_playerbeams.Clear();
 }
 
 static void CLG_ParseBeam(qhandle_t model)
@@ -509,24 +510,25 @@ static void CLG_ParseBeam(qhandle_t model)
 	int     i;
 
 	// override any beam with the same source AND destination entities
-	for (i = 0, b = clg_beams; i < MAX_BEAMS; i++, b++)
+	for (i = 0; i < clg_beams.GetNumberOfActive(); i++) {
+		b = clg_beams.GetActive(i);
 		if (b->entity == teParameters.entity1 && b->dest_entity == teParameters.entity2)
 			goto override;
-
-	// find a free beam
-	for (i = 0, b = clg_beams; i < MAX_BEAMS; i++, b++) {
-		if (!b->model || b->endTime < cl->time) {
-			override :
-				b->entity = teParameters.entity1;
-			b->dest_entity = teParameters.entity2;
-			b->model = model;
-			b->endTime = cl->time + 200;
-			VectorCopy(teParameters.position1, b->start);
-			VectorCopy(teParameters.position2, b->end);
-			VectorCopy(teParameters.offset, b->offset);
-			return;
-		}
 	}
+
+	// grab a free beam, expired ones are freed by CLG_AddBeams
+	b = clg_beams.Alloc();
+	if (!b)
+		return;
+
+override:
+	b->entity = teParameters.entity1;
+	b->dest_entity = teParameters.entity2;
+	b->model = model;
+	b->endTime = cl->time + 200;
+	VectorCopy(teParameters.position1, b->start);
+	VectorCopy(teParameters.position2, b->end);
+	VectorCopy(teParameters.offset, b->offset);
 }
 
 static void CLG_ParsePlayerBeam(qhandle_t model)
@@ -535,7 +537,8 @@ static void CLG_ParsePlayerBeam(qhandle_t model)
 	int     i;
 
 	// override any beam with the same entity
-	for (i = 0, b = clg_playerbeams; i < MAX_BEAMS; i++, b++) {
+	for (i = 0; i < clg_playerbeams.GetNumberOfActive(); i++) {
+		b = clg_playerbeams.GetActive(i);
 		if (b->entity == teParameters.entity1) {
 			b->entity = teParameters.entity1;
 			b->model = model;
@@ -547,19 +550,17 @@ static void CLG_ParsePlayerBeam(qhandle_t model)
 		}
 	}
 
-	// find a free beam
-	for (i = 0, b = clg_playerbeams; i < MAX_BEAMS; i++, b++) {
-		if (!b->model || b->endTime < cl->time) {
-			b->entity = teParameters.entity1;
-			b->model = model;
-			b->endTime = cl->time + 100;     // PMM - this needs to be 100 to prevent multiple heatbeams
-			VectorCopy(teParameters.position1, b->start);
-			VectorCopy(teParameters.position2, b->end);
-			VectorCopy(teParameters.offset, b->offset);
-			return;
-		}
-	}
+	// grab a free beam, expired ones are freed by CLG_AddPlayerBeams
+	b = clg_playerbeams.Alloc();
+	if (!b)
+		return;
 
+	b->entity = teParameters.entity1;
+	b->model = model;
+	b->endTime = cl->time + 100;     // PMM - this needs to be 100 to prevent multiple heatbeams
+	VectorCopy(teParameters.position1, b->start);
+	VectorCopy(teParameters.position2, b->end);
+	VectorCopy(teParameters.offset, b->offset);
 }
 
 /*
@@ -579,9 +580,12 @@ static void CLG_AddBeams(void)
 	float       model_length;
 
 	// update beams
-	for (i = 0, b = clg_beams; i < MAX_BEAMS; i++, b++) {
-		if (!b->model || b->endTime < cl->time)
+	for (i = clg_beams.GetNumberOfActive() - 1; i >= 0; i--) {
+		b = clg_beams.GetActive(i);
+		if (!b->model || b->endTime < cl->time) {
+			clg_beams.Free(b);
 			continue;
+		}
 
 		// if coming from the player, update the start position
 		if (b->entity == cl->frame.clientNumber + 1)
@@ -618,7 +622,7 @@ static void CLG_AddBeams(void)
 			ent.angles[1] = angles[1];
 			ent.angles[2] = rand() % 360;
 			clge->view->AddRenderEntity(ent);
-			return;
+			continue;
 		}
 
 		while (d > 0) {
@@ -675,9 +679,12 @@ static void CLG_AddPlayerBeams(void)
 	ViewCamera *viewCamera = clge->view->GetViewCamera();
 
 	// update beams
-	for (i = 0, b = clg_playerbeams; i < MAX_BEAMS; i++, b++) {
-		if (!b->model || b->endTime < cl->time)
+	for (i = clg_playerbeams.GetNumberOfActive() - 1; i >= 0; i--) {
+		b = clg_playerbeams.GetActive(i);
+		if (!b->model || b->endTime < cl->time) {
+			clg_playerbeams.Free(b);
 			continue;
+		}
 
 		// if coming from the player, update the start position
 		if (b->entity == cl->frame.clientNumber + 1) {
@@ -780,26 +787,18 @@ static void CLG_AddPlayerBeams(void)
 //=============================================================================
 //
 
-#define MAX_SUSTAINS    32
+#define MAX_SUSTAINS    64
 
-static cl_sustain_t     clg_sustains[MAX_SUSTAINS];
+static CLGPool<cl_sustain_t, MAX_SUSTAINS> clg_sustains;
 
 static void CLG_ClearSustains(void)
 {
-	memset(clg_sustains, 0, sizeof(clg_sustains));
+	clg_sustains.Clear();
 }
 
 static cl_sustain_t* CLG_AllocSustain(void)
 {
-	cl_sustain_t* s;
-	int             i;
-
-	for (i = 0, s = clg_sustains; i < MAX_SUSTAINS; i++, s++) {
-		if (s->id == 0)
-			return s;
-	}
-
-	return NULL;
+	return clg_sustains.Alloc();
 }
 
 static void CLG_ProcessSustain(void)
@@ -807,13 +806,12 @@ static void CLG_ProcessSustain(void)
 	cl_sustain_t* s;
 	int             i;
 
-	for (i = 0, s = clg_sustains; i < MAX_SUSTAINS; i++, s++) {
-		if (s->id) {
-			if ((s->endTime >= cl->time) && (cl->time >= s->nextThinkTime))
-				s->Think(s);
-			else if (s->endTime < cl->time)
-				s->id = 0;
-		}
+	for (i = clg_sustains.GetNumberOfActive() - 1; i >= 0; i--) {
+		s = clg_sustains.GetActive(i);
+		if ((s->endTime >= cl->time) && (cl->time >= s->nextThinkTime))
+			s->Think(s);
+		else if (s->endTime < cl->time)
+			clg_sustains.Free(s);
 	}
 }
 
@@ -0,0 +1,153 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Parallel For implementation.
+*
+***/
+#include "../ClientGameLocals.h"
+
+#include "CLGParallelFor.h"
+
+#include <atomic>
+#include <mutex>
+
+
+//! Maximum amount of worker threads.
+static constexpr int32_t CLG_MAX_PARALLEL_THREADS = 16;
+//! Don't bother waking up the workers for less items than this.
+static constexpr int32_t CLG_PARALLEL_MIN_ITEMS = 4;
+
+//! Worker pool state.
+static struct {
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable workReady;
+	std::condition_variable workDone;
+
+	//! Current job.
+	CLG_ParallelForFunction function = nullptr;
+	void *userData = nullptr;
+	int32_t count = 0;
+	//! Next index to hand out.
+	std::atomic<int32_t> nextIndex = 0;
+	//! Workers that have yet to finish the current job.
+	int32_t busyWorkers = 0;
+	//! Incremented for each job, so workers know when there is new work.
+	uint64_t jobNumber = 0;
+
+	bool shutdown = false;
+} clg_parallel;
+
+
+
+/**
+*	@brief	Runs items of the current job until there are none left.
+**/
+static void CLG_RunParallelItems( CLG_ParallelForFunction function, void *userData, const int32_t count ) {
+	for ( int32_t index = clg_parallel.nextIndex.fetch_add( 1 ); index < count; index = clg_parallel.nextIndex.fetch_add( 1 ) ) {
+		function( index, userData );
+	}
+}
+
+/**
+*	@brief	Worker thread main loop.
+**/
+static void CLG_ParallelWorker() {
+	uint64_t lastJobNumber = 0;
+
+	std::unique_lock<std::mutex> lock( clg_parallel.mutex );
+	while ( true ) {
+		clg_parallel.workReady.wait( lock, [&lastJobNumber] { return clg_parallel.shutdown || clg_parallel.jobNumber != lastJobNumber; } );
+		if ( clg_parallel.shutdown ) {
+			return;
+		}
+		lastJobNumber = clg_parallel.jobNumber;
+
+		// Work on the job without holding the lock.
+		CLG_ParallelForFunction function = clg_parallel.function;
+		void *userData = clg_parallel.userData;
+		const int32_t count = clg_parallel.count;
+
+		lock.unlock();
+		CLG_RunParallelItems( function, userData, count );
+		lock.lock();
+
+		if ( --clg_parallel.busyWorkers == 0 ) {
+			clg_parallel.workDone.notify_one();
+		}
+	}
+}
+
+/**
+*	@brief	Starts the worker threads if there are none yet.
+**/
+static void CLG_StartParallelFor() {
+	if ( !clg_parallel.threads.empty() ) {
+		return;
+	}
+
+	// Leave a core for the main thread.
+	const int32_t numThreads = Clampi( (int32_t)std::thread::hardware_concurrency() - 1, 0, CLG_MAX_PARALLEL_THREADS );
+
+	clg_parallel.shutdown = false;
+	for ( int32_t i = 0; i < numThreads; i++ ) {
+		clg_parallel.threads.emplace_back( CLG_ParallelWorker );
+	}
+}
+
+/**
+*	@brief	Calls function( index, userData ) for each index in [0, count) spread over the worker
+*			threads, and returns once all of them are done.
+**/
+void CLG_ParallelFor( const int32_t count, CLG_ParallelForFunction function, void *userData ) {
+	if ( count <= 0 || !function ) {
+		return;
+	}
+
+	CLG_StartParallelFor();
+
+	// Not worth the hassle.
+	if ( clg_parallel.threads.empty() || count < CLG_PARALLEL_MIN_ITEMS ) {
+		for ( int32_t index = 0; index < count; index++ ) {
+			function( index, userData );
+		}
+		return;
+	}
+
+	// Publish the job.
+	{
+		std::lock_guard<std::mutex> lock( clg_parallel.mutex );
+		clg_parallel.function = function;
+		clg_parallel.userData = userData;
+		clg_parallel.count = count;
+		clg_parallel.nextIndex = 0;
+		clg_parallel.busyWorkers = (int32_t)clg_parallel.threads.size();
+		clg_parallel.jobNumber++;
+	}
+	clg_parallel.workReady.notify_all();
+
+	// Help out, then wait for the workers to finish their last items.
+	CLG_RunParallelItems( function, userData, count );
+
+	std::unique_lock<std::mutex> lock( clg_parallel.mutex );
+	clg_parallel.workDone.wait( lock, [] { return clg_parallel.busyWorkers == 0; } );
+}
+
+/**
+*	@brief	Stops, and joins all worker threads.
+**/
+void CLG_ShutdownParallelFor() {
+	{
+		std::lock_guard<std::mutex> lock( clg_parallel.mutex );
+		clg_parallel.shutdown = true;
+	}
+	clg_parallel.workReady.notify_all();
+
+	for ( auto &thread : clg_parallel.threads ) {
+		thread.join();
+	}
+	clg_parallel.threads.clear();
+}
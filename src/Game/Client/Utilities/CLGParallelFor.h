@@ -0,0 +1,28 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Parallel For: Spreads independent per item work (Such as entity skeleton poses) over a small
+*	pool of persistent worker threads. The calling thread takes part in the work as well.
+*
+***/
+#pragma once
+
+
+
+//! Work function, called once for each item index.
+using CLG_ParallelForFunction = void (*)( const int32_t index, void *userData );
+
+/**
+*	@brief	Calls function( index, userData ) for each index in [0, count) spread over the worker
+*			threads, and returns once all of them are done. Falls back to a plain loop if there are
+*			no worker threads, or too few items to make it worth it.
+**/
+void CLG_ParallelFor( const int32_t count, CLG_ParallelForFunction function, void *userData );
+
+/**
+*	@brief	Stops, and joins all worker threads. They are restarted on demand by CLG_ParallelFor.
+**/
+void CLG_ShutdownParallelFor();
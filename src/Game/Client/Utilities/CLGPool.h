@@ -0,0 +1,112 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Pool: Fixed capacity storage for short lived effect items. (Explosions, beams, lasers,
+*	sustains.) Allocating and freeing is O(1) through a free list, and the allocated items
+*	are kept in a dense list so that per frame updates only visit the active ones.
+*
+***/
+#pragma once
+
+
+
+/**
+*	@brief	Fixed capacity pool of T, with O(1) alloc/free and dense iteration over the active items.
+*
+*			Iterate the active items back to front, that way the current item can be freed
+*			while iterating:
+*
+*			for ( int32_t i = pool.GetNumberOfActive() - 1; i >= 0; i-- ) {
+*				T *item = pool.GetActive( i );
+*				...
+*				pool.Free( item );
+*			}
+**/
+template<typename T, int32_t Capacity>
+class CLGPool {
+public:
+	static_assert( Capacity > 0, "Pool capacity has to be positive" );
+
+	CLGPool() {
+		Clear();
+	}
+
+	/**
+	*	@brief	Frees all items.
+	**/
+	void Clear() {
+		for ( int32_t slot = 0; slot < Capacity; slot++ ) {
+			items[ slot ] = T{};
+			// Hand out the lowest slots first.
+			freeSlots[ slot ] = Capacity - 1 - slot;
+			activePositions[ slot ] = -1;
+		}
+		numberOfFree = Capacity;
+		numberOfActive = 0;
+	}
+
+	/**
+	*	@return	A default initialized item, nullptr if the pool is full.
+	**/
+	T *Alloc() {
+		if ( !numberOfFree ) {
+			return nullptr;
+		}
+
+		const int32_t slot = freeSlots[ --numberOfFree ];
+		activePositions[ slot ] = numberOfActive;
+		activeSlots[ numberOfActive++ ] = slot;
+
+		items[ slot ] = T{};
+		return &items[ slot ];
+	}
+
+	/**
+	*	@brief	Returns the item to the pool. The last active item takes its place in the
+	*			active list.
+	**/
+	void Free( T *item ) {
+		const int32_t slot = (int32_t)( item - items );
+		if ( slot < 0 || slot >= Capacity || activePositions[ slot ] == -1 ) {
+			return;
+		}
+
+		const int32_t position = activePositions[ slot ];
+		const int32_t lastSlot = activeSlots[ --numberOfActive ];
+		activeSlots[ position ] = lastSlot;
+		activePositions[ lastSlot ] = position;
+
+		activePositions[ slot ] = -1;
+		freeSlots[ numberOfFree++ ] = slot;
+	}
+
+	/**
+	*	@return	The number of allocated items.
+	**/
+	inline const int32_t GetNumberOfActive() const { return numberOfActive; }
+	/**
+	*	@return	True if there are no free items left.
+	**/
+	inline const bool IsFull() const { return numberOfFree == 0; }
+	/**
+	*	@return	The index'th allocated item, index has to be below GetNumberOfActive.
+	**/
+	inline T *GetActive( const int32_t index ) { return &items[ activeSlots[ index ] ]; }
+
+private:
+	//! Item storage.
+	T items[ Capacity ] = {};
+
+	//! Stack of free slots.
+	int32_t freeSlots[ Capacity ] = {};
+	int32_t numberOfFree = 0;
+
+	//! Dense list of the allocated slots.
+	int32_t activeSlots[ Capacity ] = {};
+	int32_t numberOfActive = 0;
+	//! Position of each slot in activeSlots, -1 if it is free.
+	int32_t activePositions[ Capacity ] = {};
+};
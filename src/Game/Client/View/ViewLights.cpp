@@ -0,0 +1,166 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	ClientGame ViewLights Implementation.
+*
+***/
+// ClientGame Locals.
+#include "../ClientGameLocals.h"
+
+#include "ViewLights.h"
+
+
+/**
+*   @brief  Clears out the candidates for a new frame.
+**/
+void ViewLights::Clear() {
+    numberOfCandidates = 0;
+}
+
+/**
+*   @brief  Adds a light candidate for the current frame.
+*   @return False when there was no candidate slot left.
+**/
+bool ViewLights::AddLight(const vec3_t &origin, const vec3_t &rgb, float intensity, float radius) {
+    if (numberOfCandidates >= MaxCandidates) {
+        return false;
+    }
+
+    rdlight_t &light = candidates[numberOfCandidates++];
+    light.origin    = origin;
+    light.color     = rgb;
+    light.intensity = intensity;
+    light.radius    = radius;
+
+    return true;
+}
+
+/**
+*   @brief  Culls, merges, and ranks the light candidates. Writes the 'budget' most
+*           contributing lights into 'dlights'.
+*   @param  mergeDistance Lights whose origins are closer than this are merged, 0 disables merging.
+*   @param  cull Whether to cull lights against the view frustum and PVS.
+*   @return The number of lights written.
+**/
+int32_t ViewLights::SubmitLights(const vec3_t &viewOrigin, const vec3_t &viewAngles, float fovX, float fovY,
+                                 rdlight_t *dlights, int32_t budget, float mergeDistance, bool cull) {
+    budget = Clampi(budget, 0, MAX_DLIGHTS);
+    if (!budget || !numberOfCandidates) {
+        return 0;
+    }
+
+    // No fov has been calculated yet on the very first frame, the planes are left zeroed
+    // so that nothing is culled against the frustum then.
+    for (int32_t i = 0; i < 4; i++) {
+        frustumNormals[i] = vec3_zero();
+        frustumDistances[i] = 0.f;
+    }
+    if (cull && fovX > 0.f && fovY > 0.f) {
+        vec3_t forward, right, up;
+        vec3_vectors(viewAngles, &forward, &right, &up);
+
+        // Inward facing normals of the left, right, bottom and top planes.
+        float sx, cx, sy, cy;
+        SinCosRadians(Radians(fovX * 0.5f), sx, cx);
+        SinCosRadians(Radians(fovY * 0.5f), sy, cy);
+
+        frustumNormals[0] = vec3_scale(forward, sx) + vec3_scale(right, cx);
+        frustumNormals[1] = vec3_scale(forward, sx) - vec3_scale(right, cx);
+        frustumNormals[2] = vec3_scale(forward, sy) + vec3_scale(up, cy);
+        frustumNormals[3] = vec3_scale(forward, sy) - vec3_scale(up, cy);
+
+        for (int32_t i = 0; i < 4; i++) {
+            frustumDistances[i] = vec3_dot(viewOrigin, frustumNormals[i]);
+        }
+    }
+
+    // Cull, and rank the candidates that are left.
+    int32_t numberOfSorted = 0;
+    for (int32_t i = 0; i < numberOfCandidates; i++) {
+        const rdlight_t &light = candidates[i];
+
+        if (cull && !IsLightVisible(light, viewOrigin)) {
+            continue;
+        }
+
+        contributions[i] = GetLightContribution(light, viewOrigin);
+        sortedCandidates[numberOfSorted++] = i;
+    }
+
+    std::sort(sortedCandidates, sortedCandidates + numberOfSorted, [this](const int32_t a, const int32_t b) {
+        return contributions[a] > contributions[b];
+    });
+
+    // Hand out the budget in order of contribution. A light close to one that has already
+    // been submitted is merged into it instead, even when the budget has been used up, so
+    // that clusters of small lights (Rail trails, explosion debris.) take up a single slot.
+    const float mergeDistanceSquared = mergeDistance * mergeDistance;
+
+    int32_t numberOfLights = 0;
+    for (int32_t i = 0; i < numberOfSorted; i++) {
+        const rdlight_t &light = candidates[sortedCandidates[i]];
+
+        bool merged = false;
+        if (mergeDistance > 0.f && light.intensity > 0.f) {
+            for (int32_t j = 0; j < numberOfLights; j++) {
+                if (dlights[j].intensity > 0.f && vec3_distance_squared(dlights[j].origin, light.origin) < mergeDistanceSquared) {
+                    MergeLight(dlights[j], light);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+
+        if (!merged && numberOfLights < budget) {
+            dlights[numberOfLights++] = light;
+        }
+    }
+
+    return numberOfLights;
+}
+
+/**
+*   @return True if the light's sphere of influence intersects the view frustum,
+*           and touches a potentially visible leaf.
+**/
+bool ViewLights::IsLightVisible(const rdlight_t &light, const vec3_t &viewOrigin) {
+    const float extent = GetLightExtent(light);
+
+    for (int32_t i = 0; i < 4; i++) {
+        if (vec3_dot(light.origin, frustumNormals[i]) - frustumDistances[i] < -extent) {
+            return false;
+        }
+    }
+
+    const vec3_t extents = { extent, extent, extent };
+    return clgi.CM_BoxInPVS(viewOrigin, light.origin - extents, light.origin + extents);
+}
+
+/**
+*   @return An estimate of how much the light contributes to what is on screen: its
+*           brightness, scaled down by the distance to the view.
+**/
+float ViewLights::GetLightContribution(const rdlight_t &light, const vec3_t &viewOrigin) {
+    const float brightness = Maxf(light.color.x, Maxf(light.color.y, light.color.z)) * fabsf(light.intensity);
+    const float extent = GetLightExtent(light);
+    const float extentSquared = extent * extent;
+
+    // A light that surrounds the view counts fully, beyond that it falls off with the squared distance.
+    return brightness * extentSquared / (extentSquared + vec3_distance_squared(light.origin, viewOrigin) + 1.f);
+}
+
+/**
+*   @brief  Merges 'light' into 'into', preserving the combined emitted light.
+**/
+void ViewLights::MergeLight(rdlight_t &into, const rdlight_t &light) {
+    const float totalIntensity = into.intensity + light.intensity;
+    const vec3_t emitted = vec3_scale(into.color, into.intensity) + vec3_scale(light.color, light.intensity);
+
+    into.origin     = vec3_scale(vec3_scale(into.origin, into.intensity) + vec3_scale(light.origin, light.intensity), 1.f / totalIntensity);
+    into.intensity  = Maxf(into.intensity, light.intensity);
+    into.color      = vec3_scale(emitted, 1.f / into.intensity);
+    into.radius     = Maxf(into.radius, light.radius);
+}
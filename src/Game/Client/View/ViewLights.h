@@ -0,0 +1,91 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	ClientGame ViewLights: Gathers all dynamic lights that are added to the view during a
+*	frame, and picks the ones that are handed to the refresh: lights outside of the view
+*	frustum or PVS are culled, lights that are close together are merged into one, and what
+*	remains is ranked by its contribution to the screen to fill up the light budget.
+*
+***/
+#pragma once
+
+
+
+/**
+*
+*    ViewLights Functionality.
+*
+**/
+class ViewLights {
+public:
+    //! Maximum amount of light candidates that can be added in a single frame.
+    static constexpr int32_t MaxCandidates = 512;
+
+    /**
+    *   @brief  Clears out the candidates for a new frame.
+    **/
+    void Clear();
+
+    /**
+    *   @brief  Adds a light candidate for the current frame.
+    *   @return False when there was no candidate slot left.
+    **/
+    bool AddLight(const vec3_t &origin, const vec3_t &rgb, float intensity, float radius);
+
+    /**
+    *   @brief  Culls, merges, and ranks the light candidates. Writes the 'budget' most
+    *           contributing lights into 'dlights'.
+    *   @param  mergeDistance Lights whose origins are closer than this are merged, 0 disables merging.
+    *   @param  cull Whether to cull lights against the view frustum and PVS.
+    *   @return The number of lights written.
+    **/
+    int32_t SubmitLights(const vec3_t &viewOrigin, const vec3_t &viewAngles, float fovX, float fovY,
+                         rdlight_t *dlights, int32_t budget, float mergeDistance, bool cull);
+
+    /**
+    *   @return The number of light candidates that were added this frame.
+    **/
+    inline const int32_t GetNumberOfCandidates() { return numberOfCandidates; }
+
+private:
+    /**
+    *   @return The distance up to which the light affects its surroundings.
+    **/
+    static inline const float GetLightExtent(const rdlight_t &light) {
+        return Maxf(light.intensity, light.radius);
+    }
+
+    /**
+    *   @return True if the light's sphere of influence intersects the view frustum,
+    *           and touches a potentially visible leaf.
+    **/
+    bool IsLightVisible(const rdlight_t &light, const vec3_t &viewOrigin);
+
+    /**
+    *   @return An estimate of how much the light contributes to what is on screen: its
+    *           brightness, scaled down by the distance to the view.
+    **/
+    float GetLightContribution(const rdlight_t &light, const vec3_t &viewOrigin);
+
+    /**
+    *   @brief  Merges 'light' into 'into', preserving the combined emitted light.
+    **/
+    static void MergeLight(rdlight_t &into, const rdlight_t &light);
+
+
+private:
+    //! The light candidates of this frame.
+    rdlight_t candidates[MaxCandidates];
+    int32_t numberOfCandidates = 0;
+
+    //! Contribution of each candidate, and the candidate indices sorted by it.
+    float contributions[MaxCandidates];
+    int32_t sortedCandidates[MaxCandidates];
+
+    //! The view frustum's side planes.
+    vec3_t frustumNormals[4];
+    float frustumDistances[4];
+};
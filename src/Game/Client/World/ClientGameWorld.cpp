@@ -143,6 +143,9 @@ void ClientGameWorld::PrepareEntities() {
 			.clientEntityNumber = i, // Last but not least, the actual clientEntityNumber.
 		};
     }
+
+	// Release the entity pool memory of the previous level in bulk.
+	SG_GetEntityPoolAllocator().ReleaseUnusedChunks();
 }
 
 /**
@@ -265,7 +268,8 @@ qboolean ClientGameWorld::PrepareBSPEntities(const char* mapName, const char* bs
     // Parsing state variables.
 	qboolean isParsing = true; // We'll keep on parsing until this is set to false.
 	qboolean parsedSuccessfully = false;// This gets set to false the immediate moment we run into parsing trouble.
-	char *com_token = nullptr; // Token pointer.
+	SGEntityStringTokenizer tokenizer(bspString); // Tokenizer for the entity string.
+	std::string_view token; // Current token.
 	PODEntity *clientEntity = nullptr; // Pointer to the client entity we intend to employ.
     uint32_t packetEntityIndex = maxClients + 1 + BODY_QUEUE_SIZE; // We start from the max clients.         
 	uint32_t localEntityIndex = MAX_WIRED_POD_ENTITIES + RESERVED_ENTITIY_COUNT; // TODO: That RESERVED_COUNT thingy.
@@ -303,22 +307,24 @@ qboolean ClientGameWorld::PrepareBSPEntities(const char* mapName, const char* bs
 	// Engage parsing.
 	while (!!isParsing == true) {
 		// Parse the opening brace.
-		com_token = COM_Parse(&bspString);
-
         // Break out when we're done and there is no string data left to parse.
-		if (!bspString) {
+		if (!tokenizer.NextToken(token)) {
 			break;
 		}
 
         // If the token isn't a {, something is off.
-		if (com_token[0] != '{') {
-		    Com_Error(ErrorType::Drop, "PrepareBSPEntities: found %s when expecting {", com_token);
+		if (token != "{") {
+		    Com_Error(ErrorType::Drop, "PrepareBSPEntities: found %s when expecting {", std::string(token).c_str());
 			return false;
 		}
 
 		// SpawnKeys.
 		SpawnKeyValues parsedKeyValues;
-        parsedSuccessfully = ParseEntityString(&bspString, parsedKeyValues);
+        parsedSuccessfully = ParseEntityString(tokenizer, parsedKeyValues);
+
+		// Classname, if any.
+		auto classnameEntry = parsedKeyValues.find("classname");
+		const std::string_view classname = (classnameEntry != parsedKeyValues.end() ? std::string_view(classnameEntry->second) : std::string_view());
 
 		// Is this entity local?
 		bool isLocal = false;
@@ -330,7 +336,7 @@ qboolean ClientGameWorld::PrepareBSPEntities(const char* mapName, const char* bs
 		PODEntity *podEntity = nullptr;
 		
 		// If the dictionary has a classname, and it has client_ residing in it, change the entity index to use.
-		if (parsedKeyValues.contains("classname") && (parsedKeyValues["classname"].find("client_") != std::string::npos || parsedKeyValues["classname"].find("_client") != std::string::npos)) {
+		if (classname.find("client_") != std::string_view::npos || classname.find("_client") != std::string_view::npos) {
 			// Increment local entity count.
 			localEntityIndex++;
 		//	//entityIndex = localEntityIndex;
@@ -338,7 +344,7 @@ qboolean ClientGameWorld::PrepareBSPEntities(const char* mapName, const char* bs
 		//	// Entity is local.
 			isLocal = true;
 			podEntity = GetUnusedPODEntity(false);
-		} else if (parsedKeyValues.contains("classname") && parsedKeyValues["classname"] == "worldspawn") {
+		} else if (classname == "worldspawn") {
 		//if (parsedKeyValues.contains("classname") && parsedKeyValues["classname"] == "worldspawn") {
 			// Just use 0 index.
 			//entityIndex = 0;
@@ -379,7 +385,7 @@ qboolean ClientGameWorld::PrepareBSPEntities(const char* mapName, const char* bs
 		}
 		
 		// Assign parsed dictionary to entity.
-		podEntity->spawnKeyValues = parsedKeyValues;
+		podEntity->spawnKeyValues = std::move(parsedKeyValues);
 	}
 
 	// Post spawn entities.
@@ -527,59 +533,30 @@ void ClientGameWorld::FindTeams() {
 *	@brief	Parses the BSP Entity string and places the results in the server
 *			entity dictionary.
 **/
-qboolean ClientGameWorld::ParseEntityString(const char** data, SpawnKeyValues &parsedKeyValues) {
-	// False until proven otherwise.
-	qboolean parsedSuccessfully = false;
-
-	// Key value ptrs.
-	char *key = nullptr, *value = nullptr;
+qboolean ClientGameWorld::ParseEntityString(SGEntityStringTokenizer &tokenizer, SpawnKeyValues &parsedKeyValues) {
+	// Key/values of the entity, pointing into the entity string. Reuses the capacity of the previous entity.
+	std::vector<SGEntityKeyValue> &keyValues = entityKeyValues;
+	keyValues.clear();
 
 	// Go through all the dictionary pairs.
-  	while (1) {
-		// Parse the key.
-		key = COM_Parse(data);
-		
-		// If we hit a }, it means we're done parsing, break out of this loop.
-		if (key[0] == '}') {
-			break;
-		}
-
-		// If we are at the end of the string without a closing brace, error out.
-		if (!*data) {
-			Com_Error(ErrorType::Drop, "%s: EOF without closing brace", __func__);
-			return false;
-		}
-
-		// Parse the value.
-		value = COM_Parse(data);
-
-		// If we are at the end of the string without a closing brace, error out.
-		if (!*data) {
-			Com_Error(ErrorType::Drop, "%s: EOF without closing brace", __func__);
-			return false;
-		}
-
-		// Ensure we had a value.
-		if (value[0] == '}') {
-			Com_Error(ErrorType::Drop, "%s: closing brace without value for key %s", __func__, key);
-			return false;
-		   }
-
-		// We successfully managed to parse this entity.
-		parsedSuccessfully = true;
+	if (tokenizer.ParseKeyValues(keyValues) == SGEntityStringTokenizer::ParseResult::Error) {
+		Com_Error(ErrorType::Drop, "%s: %s", __func__, tokenizer.GetErrorString());
+		return false;
+	}
 
+	for (const SGEntityKeyValue &keyValue : keyValues) {
 		// keynames with a leading underscore are used for utility comments,
 		// and are immediately discarded by quake
-		if (key[0] == '_') {
+		if (!keyValue.key.empty() && keyValue.key[0] == '_') {
 			continue;
 		}
 
-		// Insert the key/value into the dictionary.
-		parsedKeyValues.try_emplace(std::string(key),std::string(value));// = value;
+		// Insert the key/value into the dictionary, the first occurrence of a key wins.
+		parsedKeyValues.emplace(keyValue.key, keyValue.value);
 	}
 
-	// Return the result.
-	return parsedSuccessfully;
+	// We successfully managed to parse this entity if it had any key/values.
+	return !keyValues.empty();
 }
 
 /**
@@ -591,14 +568,15 @@ qboolean ClientGameWorld::CreateGameEntityFromDictionary(PODEntity *podEntity, S
     const int32_t clientEntityNumber = podEntity->clientEntityNumber;
 
     // If it does not have a classname key we're in for trouble.
-    if (!dictionary.contains("classname") || dictionary["classname"].empty()) {
+    auto classnameEntry = dictionary.find("classname");
+    if (classnameEntry == dictionary.end() || classnameEntry->second.empty()) {
 		// For the ClientGame we only do some simple warning print.
 		Com_WPrint("CLGWarning: Can't spawn ClientGameEntity for PODEntity(#%i) due to a missing 'classname' key/value.\n", __func__, clientEntityNumber);
 		return false;
     }
 
     // Actually spawn the game entity.
-    IClientGameEntity *gameEntity = CreateGameEntityFromClassname(podEntity, dictionary["classname"]);
+    IClientGameEntity *gameEntity = CreateGameEntityFromClassname(podEntity, classnameEntry->second);
 	
     // This only happens if something went badly wrong. (It shouldn't.)
     if (!gameEntity) {
@@ -617,7 +595,7 @@ qboolean ClientGameWorld::CreateGameEntityFromDictionary(PODEntity *podEntity, S
 		//podEntity->clientEntityNumber = stateNumber;
 
 		// Failed.
-		Com_DPrint("CLGWarning: Spawning entity(%s) failed.\n", dictionary["classname"].c_str());
+		Com_DPrint("CLGWarning: Spawning entity(%s) failed.\n", classnameEntry->second.c_str());
 		return false;
 	}
 	
@@ -317,6 +317,9 @@ private:
 	//! Currently active game mode.
     IGameMode* currentGameMode = nullptr;
 
+	//! Key/values of the entity being parsed by ParseEntityString.
+	std::vector<SGEntityKeyValue> entityKeyValues;
+
 
     
 private:
@@ -368,7 +371,7 @@ private:
 	*			entity dictionary.
 	*	@return	True in case it succeeded parsing the entity string.
 	**/
-	qboolean ParseEntityString(const char** data, SpawnKeyValues &parsedKeyValues);
+	qboolean ParseEntityString(SGEntityStringTokenizer &tokenizer, SpawnKeyValues &parsedKeyValues);
 
 
     /**
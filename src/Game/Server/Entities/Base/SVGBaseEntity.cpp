@@ -33,6 +33,15 @@ vec3_t SVGBaseEntity::ZeroVec3 = vec3_zero();
 // Constructor/Deconstructor.
 SVGBaseEntity::SVGBaseEntity(PODEntity *svEntity) : IServerGameEntity() {
 	podEntity = svEntity;
+
+	// Start out with fresh hot state values in our POD entity's slot. Without one we
+	// use our own, already default initialized, storage.
+	hotStates = &GetGameWorld()->GetEntityHotStates();
+	hotStateSlot = EntityHotStates::GetSlot( svEntity );
+	if ( hotStateSlot != EntityHotStates::NoPODEntitySlot ) {
+		hotStates->Reset( hotStateSlot );
+		hotStates->Wake( hotStateSlot );
+	}
 }
 
 // Interface functions. 
@@ -412,6 +421,7 @@ void SVGBaseEntity::UnlinkEntity() {
 void SVGBaseEntity::Remove()
 {
 	podEntity->serverFlags |= EntityServerFlags::Remove;
+	WakeHotState();
 }
 
 /**
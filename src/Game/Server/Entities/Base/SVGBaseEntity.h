@@ -12,6 +12,9 @@
 ***/
 #pragma once
 
+// Hot simulation fields store.
+#include "../../World/EntityHotStates.h"
+
 // Forward declare the entity handle object class.
 class SGEntityHandle;
 
@@ -155,6 +158,19 @@ public:
     **/
     virtual void SetPODEntity(PODEntity *svEntity) final {
         podEntity = svEntity;
+
+        // Move our hot state values over to the new slot, or into our own storage if we got detached.
+        const int32_t newHotStateSlot = EntityHotStates::GetSlot( svEntity );
+        if ( newHotStateSlot != hotStateSlot ) {
+            if ( hotStateSlot != EntityHotStates::NoPODEntitySlot ) {
+                ownHotState = hotStates->Read( hotStateSlot );
+                hotStates->Reset( hotStateSlot );
+            }
+            hotStateSlot = newHotStateSlot;
+            if ( hotStateSlot != EntityHotStates::NoPODEntitySlot ) {
+                hotStates->Write( hotStateSlot, ownHotState );
+            }
+        }
     }
 
 
@@ -264,8 +280,8 @@ public:
     /**
     *   @brief Get/Set: Angular Velocity
     **/
-    virtual const vec3_t&    GetAngularVelocity() override { return angularVelocity; }
-    virtual void             SetAngularVelocity(const vec3_t& angularVelocity) override { this->angularVelocity = angularVelocity; }
+    virtual const vec3_t&    GetAngularVelocity() override { return HotAngularVelocity(); }
+    virtual void             SetAngularVelocity(const vec3_t& angularVelocity) override { HotAngularVelocity() = angularVelocity; WakeHotState(); }
 
     /**
     *   @return The local center(model-space) of the entity's Bounding Box.
@@ -349,8 +365,8 @@ public:
     /**
     *   @brief Get/Set: Flags
     **/
-    virtual const int32_t    GetFlags() override { return flags; }
-    virtual void             SetFlags(const int32_t flags) override { this->flags = flags; }
+    virtual const int32_t    GetFlags() override { return HotFlags(); }
+    virtual void             SetFlags(const int32_t flags) override { HotFlags() = flags; }
 
     /**
     *   @brief Get/Set: Animation Frame
@@ -393,7 +409,7 @@ public:
     *   @brief Is/Set: In Use.
     **/
     virtual const qboolean   IsInUse() override { return podEntity->inUse; }
-    virtual void             SetInUse(const qboolean inUse) override { podEntity->inUse = inUse; }
+    virtual void             SetInUse(const qboolean inUse) override { podEntity->inUse = inUse; WakeHotState(); }
 
     /**
     *   @brief Get/Set: Kill Target.
@@ -476,14 +492,21 @@ public:
     /**
     *   @brief Get/Set: Move Type.
     **/
-    virtual const int32_t    GetMoveType() override { return moveType; } 
-    virtual void             SetMoveType(const int32_t moveType) override { this->moveType = moveType; }
+    virtual const int32_t    GetMoveType() override { return HotMoveType(); } 
+    virtual void             SetMoveType(const int32_t moveType) override { HotMoveType() = moveType; WakeHotState(); }
 
     /**
     *   @brief Get/Set:     NextThink Time.
     **/
-    virtual const GameTime&  GetNextThinkTime() override { return nextThinkTime; }
-    virtual void             SetNextThinkTime(const Frametime& nextThinkTime) override { this->nextThinkTime = duration_cast<GameTime>(nextThinkTime); }
+    virtual const GameTime&  GetNextThinkTime() override { return ( hotStateSlot != EntityHotStates::NoPODEntitySlot ? hotStates->nextThinkTimes[hotStateSlot] : ownHotState.nextThinkTime ); }
+    virtual void             SetNextThinkTime(const Frametime& nextThinkTime) override {
+        if (hotStateSlot != EntityHotStates::NoPODEntitySlot) {
+            hotStates->SetNextThinkTime(hotStateSlot, duration_cast<GameTime>(nextThinkTime));
+            hotStates->Wake(hotStateSlot);
+        } else {
+            ownHotState.nextThinkTime = duration_cast<GameTime>(nextThinkTime);
+        }
+    }
 
     /**
     *   @brief Get/Set:     Noise Index A
@@ -519,7 +542,7 @@ public:
     *   @brief Get/Set:     Origin
     **/
     virtual const vec3_t&    GetOrigin() override { return podEntity->currentState.origin; }
-    virtual void             SetOrigin(const vec3_t& origin) override { podEntity->currentState.origin = origin; }
+    virtual void             SetOrigin(const vec3_t& origin) override { podEntity->currentState.origin = origin; WakeHotState(); }
 
     /**
     *   @brief Get/Set:     Owner Entity
@@ -542,7 +565,7 @@ public:
     *   @brief Get/Set:     Server Flags
     **/
     virtual const int32_t    GetServerFlags() override { return podEntity->serverFlags; }
-    virtual void             SetServerFlags(const int32_t serverFlags) override { podEntity->serverFlags = serverFlags; }
+    virtual void             SetServerFlags(const int32_t serverFlags) override { podEntity->serverFlags = serverFlags; WakeHotState(); }
 
     /**
     *   @brief Get/Set:     Skin Number
@@ -631,8 +654,8 @@ public:
     /**
     *   @brief Get/Set:     Velocity
     **/
-    virtual const vec3_t& GetVelocity() override { return velocity; }
-    virtual void SetVelocity(const vec3_t &velocity) override { this->velocity = velocity; }
+    virtual const vec3_t& GetVelocity() override { return HotVelocity(); }
+    virtual void SetVelocity(const vec3_t &velocity) override { HotVelocity() = velocity; WakeHotState(); }
 
     /**
     *   @brief Get/Set:     View Height
@@ -703,11 +726,37 @@ protected:
     //Entity *podEntity = nullptr;
 
 
+    /**
+    *   Entity Hot States. (Flags, Move Type, Velocities, Next Think Time.)
+    **/
+    //! Store that holds our hot simulation fields, owned by the game world.
+    EntityHotStates *hotStates = nullptr;
+    //! Our slot in the hot states store, matches our POD entity's number.
+    int32_t hotStateSlot = EntityHotStates::NoPODEntitySlot;
+    //! Our hot state values while we have no POD entity, and thus no slot. (Item instances,
+    //! or after having been detached in SVG_FreeEntity.)
+    EntityHotState ownHotState = {};
+
+    /**
+    *   @return The hot state field in our slot, or in our own storage if we have no slot.
+    **/
+    inline vec3_t &HotVelocity() { return ( hotStateSlot != EntityHotStates::NoPODEntitySlot ? hotStates->velocities[hotStateSlot] : ownHotState.velocity ); }
+    inline vec3_t &HotAngularVelocity() { return ( hotStateSlot != EntityHotStates::NoPODEntitySlot ? hotStates->angularVelocities[hotStateSlot] : ownHotState.angularVelocity ); }
+    inline int32_t &HotMoveType() { return ( hotStateSlot != EntityHotStates::NoPODEntitySlot ? hotStates->moveTypes[hotStateSlot] : ownHotState.moveType ); }
+    inline int32_t &HotFlags() { return ( hotStateSlot != EntityHotStates::NoPODEntitySlot ? hotStates->flags[hotStateSlot] : ownHotState.flags ); }
+    /**
+    *   @brief  Makes SVG_RunFrame process us. Entities without a slot aren't run, so there is nothing to wake.
+    **/
+    inline void WakeHotState() {
+        if ( hotStateSlot != EntityHotStates::NoPODEntitySlot ) {
+            hotStates->Wake( hotStateSlot );
+        }
+    }
+
+
     /**
     *   Entity Flags
     **/
-    //! Entity flags, general flags, flags... :) 
-    int32_t flags = 0;
     //! Entity spawn flags (Such as, is this a dropped item?)
     int32_t spawnFlags = 0;
 	//! Entity 'use' flags. Determines how the player can 'Use' interact with this entity.
@@ -735,8 +784,6 @@ protected:
     /**
     *   Entity Category Types (Move, Water, what have ya? Add in here.)
     **/
-    //! Move Type. (MoveType::xxx)
-    int32_t moveType = MoveType::None;
     //! WaterType::xxxx
     int32_t waterType = 0; // TODO: Introduce WaterType "enum".
     //! WaterLevel::xxxx
@@ -746,10 +793,6 @@ protected:
     /**
     *   Entity Physics
     **/
-    //! Velocity.
-    vec3_t velocity = vec3_zero();
-    //! Angular Velocity.
-    vec3_t angularVelocity = vec3_zero();
     //! Mass
     int32_t mass = 0;
     //! Per entity gravity multiplier (1.0 is normal). TIP: Use for lowgrav artifact, flares
@@ -784,8 +827,6 @@ protected:
     /**
     *   Entity 'Timing'
     **/
-    //! The next 'think' time, determines when to call the 'think' callback.
-    GameTime nextThinkTime = GameTime::zero();
     //! Delay before calling trigger execution.
     Frametime delayTime = Frametime::zero();
     //! Wait time before triggering at all, in case it was set to auto.
@@ -156,9 +156,6 @@ const bool SVGBaseRootMotionMonster::GetAnimationFrameTranslate( const int32_t a
 		// TODO: gi.DPrintf("");
 		return false;
 	}
-	
-	// Get our current animation state.
-	const EntityAnimationState *animationState = GetCurrentAnimationState();
 
 	// It is valid, get a hold of the animation data.
 	auto animationData = skm->actions[actionIndex];
@@ -167,13 +164,13 @@ const bool SVGBaseRootMotionMonster::GetAnimationFrameTranslate( const int32_t a
 	auto &frameTranslates= animationData->frameTranslates;
 
 	// Ensure the frame is within bounds of the pre-calculated translates.
-	if ( actionIndex < 0 || actionIndex >= frameTranslates.size() ) {
+	if ( actionFrame < 0 || actionFrame >= frameTranslates.size() ) {
 		// Can't find Translation data.
 		rootBoneTranslation = vec3_zero();
 		// Failure.
 		return false;
 	} else {
-		rootBoneTranslation = frameTranslates[actionIndex];
+		rootBoneTranslation = frameTranslates[actionFrame];
 
 		// See if there are any specific rootBoneAxisFlags set.
 		const int32_t rootBoneAxisFlags = animationData->rootBoneAxisFlags;
@@ -194,9 +191,6 @@ const bool SVGBaseRootMotionMonster::GetAnimationFrameTranslate( const int32_t a
 		// Success.
 		return true;
 	}
-
-	// Should not happen.
-	return false;
 }
 const bool SVGBaseRootMotionMonster::GetAnimationFrameTranslate( const std::string &actionName, const int32_t actionFrame, vec3_t& rootBoneTranslation ) {
 	// Need a valid skm.
@@ -206,12 +200,13 @@ const bool SVGBaseRootMotionMonster::GetAnimationFrameTranslate( const std::stri
 	}
 
 	// See if the animation data exists.
-	if ( !skm->actionMap .contains( actionName ) ) {
+	auto actionIterator = skm->actionMap.find( actionName );
+	if ( actionIterator == skm->actionMap.end() ) {
 		// TODO: gi.DPrintf("");
 		return false;
 	}
 
-	return GetAnimationFrameTranslate( actionName, actionFrame, rootBoneTranslation );
+	return GetAnimationFrameTranslate( actionIterator->second.index, actionFrame, rootBoneTranslation );
 }
 /**
 *	@brief	Sets the 'distance' double to the value of the 'root bones' requested frame number 
@@ -230,9 +225,6 @@ const bool SVGBaseRootMotionMonster::GetAnimationFrameDistance( const int32_t ac
 		// TODO: gi.DPrintf("");
 		return false;
 	}
-	
-	// Get our current animation state.
-	const EntityAnimationState *animationState = GetCurrentAnimationState();
 
 	// It is valid, get a hold of the animation data.
 	auto *animationData = skm->actions[actionIndex];
@@ -249,9 +241,6 @@ const bool SVGBaseRootMotionMonster::GetAnimationFrameDistance( const int32_t ac
 		rootBoneDistance = frameDistances[actionFrame];
 		return true;
 	}
-
-	// Should not happen.
-	return false;
 }
 const bool SVGBaseRootMotionMonster::GetAnimationFrameDistance( const std::string &actionName, const int32_t actionFrame, double &rootBoneDistance ) {
 	// Need a valid skm.
@@ -261,12 +250,13 @@ const bool SVGBaseRootMotionMonster::GetAnimationFrameDistance( const std::strin
 	}
 
 	// See if the action data exists.
-	if ( !skm->actionMap.contains( actionName ) ) {
+	auto actionIterator = skm->actionMap.find( actionName );
+	if ( actionIterator == skm->actionMap.end() ) {
 		// TODO: gi.DPrintf("");
 		return false;
 	}
 
-	return GetAnimationFrameDistance( actionName, actionFrame, rootBoneDistance );
+	return GetAnimationFrameDistance( actionIterator->second.index, actionFrame, rootBoneDistance );
 }
 
 /**
@@ -93,7 +93,7 @@ public:
 	/**
 	*	This stores the model data for now.
 	**/
-	qhandle_t modelHandle;
+	qhandle_t modelHandle = 0;
 	SkeletalModelData *skm;
 
 	/**
@@ -199,7 +199,7 @@ void FuncButton::ButtonFire() {
 	}
 
 	moveInfo.state = MoverState::Up;
-	if ( moveInfo.startSoundIndex && !(flags & EntityFlags::TeamSlave) ) {
+	if ( moveInfo.startSoundIndex && !(GetFlags() & EntityFlags::TeamSlave) ) {
 		gi.Sound( podEntity, SoundChannel::IgnorePHS + SoundChannel::Voice, moveInfo.startSoundIndex, 1, Attenuation::Static, 0 );
 	}
 	
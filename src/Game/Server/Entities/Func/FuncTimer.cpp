@@ -41,7 +41,7 @@ void FuncTimer::Spawn() {
 	}
 
 	if ( spawnFlags & SF_StartOn ) {
-		nextThinkTime = duration_cast<GameTime>(level.time + 1s + pauseTime + delayTime + waitTime + crandom() * randomTime);
+		SetNextThinkTime( duration_cast<GameTime>(level.time + 1s + pauseTime + delayTime + waitTime + crandom() * randomTime) );
 		SetActivator(this);
 	}
 
@@ -79,7 +79,7 @@ void FuncTimer::TimerUse( IServerGameEntity* other, IServerGameEntity* activator
 	SetActivator(activator);
 
 	// If on, turn it off
-	if ( nextThinkTime != GameTime::zero() ) {
+	if ( GetNextThinkTime() != GameTime::zero() ) {
 		SetNextThinkTime( GameTime::zero() );
 		return;
 	}
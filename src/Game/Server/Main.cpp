@@ -551,13 +551,16 @@ void SVG_RunFrame(void) {
     //GameEntityVector gameEntities = game.world->GetGameEntities();
 	ServerGameWorld *gameWorld = GetGameWorld();
 	//Entity* serverEntities = gameWorld->GetPODEntities();
-    // Loop through the server entities, and run the base entity frame if any exists.
-    for (int32_t i = 1; i < globals.numberOfEntities; i++) {
-        // Acquire state number.
-        //int32_t stateNumber = serverEntities[i].currentState.number;
-		int32_t stateNumber = globals.entities[i].currentState.number;
+	EntityHotStates &entityHotStates = gameWorld->GetEntityHotStates();
 
-		const int32_t entityIndex = stateNumber;
+	// Wake up the entities that have their think due this frame.
+	entityHotStates.WakeDueThinks(level.time);
+
+    // Loop through the awake server entities, and run the base entity frame if any exists. Sleeping
+	// entities are idle: no think due, nothing moving them. They're woken up again by their
+	// scheduled think, or by anything that changes their hot state.
+    for (int32_t i = entityHotStates.GetNextAwakeSlot(1); i >= 0 && i < globals.numberOfEntities; i = entityHotStates.GetNextAwakeSlot(i + 1)) {
+		const int32_t entityIndex = i;
 		PODEntity *podEntity = gameWorld->GetPODEntityByIndex(entityIndex);
 		SGEntityHandle geHandle = podEntity;
 		GameEntity *gameEntity = ServerGameWorld::ValidateEntity( geHandle );
@@ -565,6 +568,10 @@ void SVG_RunFrame(void) {
 		// If invalid for whichever reason, warn and continue to next iteration.
         if (!podEntity || !gameEntity || !podEntity->inUse) {
             //Com_DPrint("ClientGameEntites::RunFrame: Entity #%i is nullptr\n", entityNumber);
+			// Nothing to do until an entity is spawned in this slot.
+			if (i > game.GetMaxClients()) {
+				entityHotStates.Sleep(entityIndex);
+			}
             continue;
         }
 
@@ -572,6 +579,7 @@ void SVG_RunFrame(void) {
         if (podEntity && gameEntity && (gameEntity->GetServerFlags() & EntityServerFlags::Remove)) {
             // Free server entity.
             game.world->FreePODEntity(podEntity);
+			entityHotStates.Sleep(entityIndex);
 
             // Be sure to unset the server entity on this SVGBaseEntity for the current frame.
             // 
@@ -632,6 +640,15 @@ void SVG_RunFrame(void) {
 
 		// Update the entities Hashed Classname, it might've changed during logic processing.
 		SVG_UpdateHashedClassName(podEntity);
+
+		// Put it to sleep if there is nothing left to do for it, and skipping it changes nothing
+		// about its POD entity. (Its old origin and hashed classname are up to date.)
+		if (podEntity->inUse && !(podEntity->serverFlags & EntityServerFlags::Remove)
+			&& podEntity->previousState.hashedClassname == podEntity->currentState.hashedClassname
+			&& vec3_equal(podEntity->currentState.oldOrigin, podEntity->currentState.origin)
+			&& entityHotStates.IsIdle(entityIndex, level.time)) {
+			entityHotStates.Sleep(entityIndex);
+		}
     }
 
     // See if it is time to end a deathmatch.
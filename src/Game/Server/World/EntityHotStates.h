@@ -0,0 +1,225 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Entity Hot States: Structure of arrays store for the game entity fields that are touched
+*	by every server frame. (Velocities, think time, move type and flags.) SVGBaseEntity reads
+*	and writes these through its accessors, which lets SVG_RunFrame decide whether an entity
+*	has anything to do without touching the game entity object itself.
+*
+*	Origin and bounding box live in the PODEntity, the engine reads them from there.
+*	Game entities without a POD entity keep their hot fields in an EntityHotState of
+*	their own instead, since they have no slot.
+*
+*	It also schedules the entities that SVG_RunFrame has to process: an entity is 'awake'
+*	while it is moving, has a think due, or had one of its hot fields changed. Idle entities
+*	are put to sleep, and woken up again when their scheduled think is due.
+*
+***/
+#pragma once
+
+// For std::countr_zero.
+#include <bit>
+
+
+/**
+*	@brief	Hot simulation fields of a single game entity. Used to move them in and out of
+*			a slot, and as storage of their own by game entities that have no POD entity.
+**/
+struct EntityHotState {
+	//! Velocity.
+	vec3_t velocity = vec3_zero();
+	//! Angular Velocity.
+	vec3_t angularVelocity = vec3_zero();
+	//! The next 'think' time, determines when to call the 'think' callback.
+	GameTime nextThinkTime = GameTime::zero();
+	//! Move Type. (MoveType::xxx)
+	int32_t moveType = MoveType::None;
+	//! Entity flags.
+	int32_t flags = 0;
+};
+
+/**
+*	@brief	Hot simulation fields of all game entities, indexed by entity number.
+**/
+struct EntityHotStates {
+	//! Number of slots, one for each POD entity.
+	static constexpr int32_t NumberOfSlots = MAX_POD_ENTITIES;
+	//! Returned by GetSlot for game entities that have no POD entity. (Such as item instances.)
+	static constexpr int32_t NoPODEntitySlot = -1;
+
+	//! Velocity.
+	vec3_t velocities[NumberOfSlots];
+	//! Angular Velocity.
+	vec3_t angularVelocities[NumberOfSlots];
+	//! The next 'think' time, determines when to call the 'think' callback.
+	GameTime nextThinkTimes[NumberOfSlots];
+	//! Move Type. (MoveType::xxx)
+	int32_t moveTypes[NumberOfSlots];
+	//! Entity flags.
+	int32_t flags[NumberOfSlots];
+
+	//! One bit per slot, set if SVG_RunFrame has to process the entity.
+	uint64_t awakeBits[( NumberOfSlots + 63 ) / 64];
+
+	//! A scheduled think. Stale once the slot's next think time no longer matches.
+	struct PendingThink {
+		GameTime time;
+		int32_t slot;
+	};
+	//! Orders the pending thinks queue, earliest on top.
+	struct PendingThinkLater {
+		bool operator()( const PendingThink &a, const PendingThink &b ) const {
+			return a.time > b.time;
+		}
+	};
+	//! Scheduled thinks, earliest first.
+	std::priority_queue<PendingThink, std::vector<PendingThink>, PendingThinkLater> pendingThinks;
+
+	/**
+	*	@return	The slot for the given POD entity.
+	**/
+	static inline const int32_t GetSlot( PODEntity *podEntity ) {
+		if ( !podEntity || podEntity->currentState.number < 0 || podEntity->currentState.number >= MAX_POD_ENTITIES ) {
+			return NoPODEntitySlot;
+		}
+		return podEntity->currentState.number;
+	}
+
+	/**
+	*	@brief	Clears all slots, and pending thinks. Called on level change.
+	**/
+	inline void Clear() {
+		for ( int32_t slot = 0; slot < NumberOfSlots; slot++ ) {
+			Reset( slot );
+		}
+		pendingThinks = {};
+	}
+
+	/**
+	*	@brief	Resets the slot to the default values of a freshly constructed entity.
+	**/
+	inline void Reset( const int32_t slot ) {
+		velocities[slot] = vec3_zero();
+		angularVelocities[slot] = vec3_zero();
+		nextThinkTimes[slot] = GameTime::zero();
+		moveTypes[slot] = MoveType::None;
+		flags[slot] = 0;
+		Sleep( slot );
+	}
+
+	/**
+	*	@return	A copy of the values in the slot.
+	**/
+	inline const EntityHotState Read( const int32_t slot ) const {
+		return {
+			.velocity = velocities[slot],
+			.angularVelocity = angularVelocities[slot],
+			.nextThinkTime = nextThinkTimes[slot],
+			.moveType = moveTypes[slot],
+			.flags = flags[slot],
+		};
+	}
+	/**
+	*	@brief	Stores the values in the slot, schedules its think, and wakes it up.
+	**/
+	inline void Write( const int32_t slot, const EntityHotState &hotState ) {
+		velocities[slot] = hotState.velocity;
+		angularVelocities[slot] = hotState.angularVelocity;
+		moveTypes[slot] = hotState.moveType;
+		flags[slot] = hotState.flags;
+		SetNextThinkTime( slot, hotState.nextThinkTime );
+		Wake( slot );
+	}
+
+	/**
+	*	@brief	Sets the next think time, and schedules it.
+	**/
+	inline void SetNextThinkTime( const int32_t slot, const GameTime &nextThinkTime ) {
+		nextThinkTimes[slot] = nextThinkTime;
+
+		if ( nextThinkTime > GameTime::zero() ) {
+			// Rebuild the queue from the think times when rescheduling has piled up too many stale entries.
+			if ( pendingThinks.size() >= NumberOfSlots * 4 ) {
+				pendingThinks = {};
+				for ( int32_t i = 0; i < NumberOfSlots; i++ ) {
+					if ( nextThinkTimes[i] > GameTime::zero() ) {
+						pendingThinks.push( { nextThinkTimes[i], i } );
+					}
+				}
+			} else {
+				pendingThinks.push( { nextThinkTime, slot } );
+			}
+		}
+	}
+
+	/**
+	*	@brief	Wakes up all entities that have a think due at time.
+	**/
+	inline void WakeDueThinks( const GameTime &time ) {
+		while ( !pendingThinks.empty() && pendingThinks.top().time <= time ) {
+			const PendingThink pendingThink = pendingThinks.top();
+			pendingThinks.pop();
+
+			// Skip it if it has been rescheduled, or cancelled since.
+			if ( nextThinkTimes[pendingThink.slot] == pendingThink.time ) {
+				Wake( pendingThink.slot );
+			}
+		}
+	}
+
+	/**
+	*	@brief	Makes SVG_RunFrame process the entity in this slot.
+	**/
+	inline void Wake( const int32_t slot ) {
+		awakeBits[slot >> 6] |= ( 1ULL << ( slot & 63 ) );
+	}
+	/**
+	*	@brief	Stops SVG_RunFrame from processing the entity in this slot, until woken up.
+	**/
+	inline void Sleep( const int32_t slot ) {
+		awakeBits[slot >> 6] &= ~( 1ULL << ( slot & 63 ) );
+	}
+	/**
+	*	@return	The first awake slot at, or after fromSlot. -1 if there is none.
+	**/
+	inline const int32_t GetNextAwakeSlot( const int32_t fromSlot ) const {
+		if ( fromSlot < 0 || fromSlot >= NumberOfSlots ) {
+			return -1;
+		}
+
+		int32_t wordIndex = fromSlot >> 6;
+		uint64_t word = awakeBits[wordIndex] & ( ~0ULL << ( fromSlot & 63 ) );
+		while ( !word ) {
+			if ( ++wordIndex >= (int32_t)std::size( awakeBits ) ) {
+				return -1;
+			}
+			word = awakeBits[wordIndex];
+		}
+
+		return ( wordIndex << 6 ) + std::countr_zero( word );
+	}
+
+	/**
+	*	@return	True if the entity in this slot has no think due at time, and its move type
+	*			won't move it this frame. SG_RunEntity would do nothing for it, so it can sleep.
+	**/
+	inline const bool IsIdle( const int32_t slot, const GameTime &time ) const {
+		// Think due?
+		if ( nextThinkTimes[slot] > GameTime::zero() && nextThinkTimes[slot] <= time ) {
+			return false;
+		}
+
+		// Only move types that do nothing but think. (Pushers move their team, tossed
+		// entities are subject to gravity, step move entities need their ground checked.)
+		const int32_t moveType = moveTypes[slot];
+		if ( moveType != MoveType::None && moveType != MoveType::NoClip && moveType != MoveType::Spectator ) {
+			return false;
+		}
+
+		// Anything moving?
+		return vec3_equal( velocities[slot], vec3_zero() ) && vec3_equal( angularVelocities[slot], vec3_zero() );
+	}
+};
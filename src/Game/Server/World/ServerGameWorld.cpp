@@ -177,6 +177,12 @@ qboolean ServerGameWorld::PrepareBSPEntities(const char* mapName, const char* en
 		gameEntities[i] = {};
     }
 
+	// Release the entity pool memory of the previous level in bulk.
+	SG_GetEntityPoolAllocator().ReleaseUnusedChunks();
+
+	// Forget about the previous level's hot states, and scheduled thinks.
+	entityHotStates.Clear();
+
 	// Copy in the map name and designated spawnpoint(if any.)
     strncpy(level.mapName, mapName, sizeof(level.mapName) - 1);
     strncpy(game.spawnpoint, spawnpoint, sizeof(game.spawnpoint) - 1);
@@ -191,8 +197,9 @@ qboolean ServerGameWorld::PrepareBSPEntities(const char* mapName, const char* en
 	qboolean isParsing = true;
 	// This gets set to false the immediate moment we run into parsing trouble.
 	qboolean parsedSuccessfully = false;
-	// Token pointer.
-	char *com_token = nullptr;
+	// Tokenizer for the entity string, and its current token.
+	SGEntityStringTokenizer tokenizer(entities);
+	std::string_view token;
 
     uint32_t packetEntityIndex = 0; // We start from the max clients.         
 	uint32_t localEntityIndex = MAX_WIRED_POD_ENTITIES; // TODO: That RESERVED_COUNT thingy.
@@ -200,20 +207,22 @@ qboolean ServerGameWorld::PrepareBSPEntities(const char* mapName, const char* en
 	// Engage parsing.
 	while (!!isParsing == true) {
 		// Parse the opening brace.
-		com_token = COM_Parse(&entities);
-
-		if (!entities) {
+		if (!tokenizer.NextToken(token)) {
 			break;
 		}
 
-		if (com_token[0] != '{') {
-			gi.Error("PrepareBSPEntities: found %s when expecting {", com_token);
+		if (token != "{") {
+			gi.Error("PrepareBSPEntities: found %s when expecting {", std::string(token).c_str());
 			return false;
 		}
 
 		// SpawnKeys.
 		SpawnKeyValues parsedKeyValues;
-        parsedSuccessfully = ParseEntityString(&entities, parsedKeyValues);
+        parsedSuccessfully = ParseEntityString(tokenizer, parsedKeyValues);
+
+		// Classname, if any.
+		auto classnameEntry = parsedKeyValues.find("classname");
+		const std::string_view classname = (classnameEntry != parsedKeyValues.end() ? std::string_view(classnameEntry->second) : std::string_view());
 
 		// Is this entity local?
 		bool isLocal = false;
@@ -225,7 +234,7 @@ qboolean ServerGameWorld::PrepareBSPEntities(const char* mapName, const char* en
 		PODEntity *podEntity = nullptr;
 		
 		// If the dictionary has a classname, and it has client_ residing in it, change the entity index to use.
-		if (parsedKeyValues.contains("classname") && (parsedKeyValues["classname"].find("client_") != std::string::npos || parsedKeyValues["classname"].find("_client") != std::string::npos)) {
+		if (classname.find("client_") != std::string_view::npos || classname.find("_client") != std::string_view::npos) {
 			// Increment local entity count.
 			localEntityIndex++;
 		//	//entityIndex = localEntityIndex;
@@ -233,7 +242,7 @@ qboolean ServerGameWorld::PrepareBSPEntities(const char* mapName, const char* en
 		//	// Entity is local.
 			isLocal = true;
 			//podEntity = GetUnusedPODEntity(false);
-		} else if (parsedKeyValues.contains("classname") && parsedKeyValues["classname"] == "worldspawn") {
+		} else if (classname == "worldspawn") {
 		//if (parsedKeyValues.contains("classname") && parsedKeyValues["classname"] == "worldspawn") {
 			// Just use 0 index.
 			//entityIndex = 0;
@@ -272,7 +281,7 @@ qboolean ServerGameWorld::PrepareBSPEntities(const char* mapName, const char* en
 		}
 		
 		// Assign parsed dictionary to entity.
-		podEntity->spawnKeyValues = parsedKeyValues;
+		podEntity->spawnKeyValues = std::move(parsedKeyValues);
 	}
 
 	// Post spawn entities.
@@ -473,59 +482,30 @@ void ServerGameWorld::FindTeams() {
 *	@brief	Parses the BSP Entity string and places the results in the server
 *			entity dictionary.
 **/
-qboolean ServerGameWorld::ParseEntityString(const char** data, SpawnKeyValues &parsedKeyValues) {
-	// False until proven otherwise.
-	qboolean parsedSuccessfully = false;
-
-	// Key value ptrs.
-	char *key = nullptr, *value = nullptr;
+qboolean ServerGameWorld::ParseEntityString(SGEntityStringTokenizer &tokenizer, SpawnKeyValues &parsedKeyValues) {
+	// Key/values of the entity, pointing into the entity string. Reuses the capacity of the previous entity.
+	std::vector<SGEntityKeyValue> &keyValues = entityKeyValues;
+	keyValues.clear();
 
 	// Go through all the dictionary pairs.
-  	while (1) {
-		// Parse the key.
-		key = COM_Parse(data);
-		
-		// If we hit a }, it means we're done parsing, break out of this loop.
-		if (key[0] == '}') {
-			break;
-		}
-
-		// If we are at the end of the string without a closing brace, error out.
-		if (!*data) {
-			Com_Error(ErrorType::Drop, "%s: EOF without closing brace", __func__);
-			return false;
-		}
-
-		// Parse the value.
-		value = COM_Parse(data);
-
-		// If we are at the end of the string without a closing brace, error out.
-		if (!*data) {
-			Com_Error(ErrorType::Drop, "%s: EOF without closing brace", __func__);
-			return false;
-		}
-
-		// Ensure we had a value.
-		if (value[0] == '}') {
-			Com_Error(ErrorType::Drop, "%s: closing brace without value for key %s", __func__, key);
-			return false;
-		   }
-
-		// We successfully managed to parse this entity.
-		parsedSuccessfully = true;
+	if (tokenizer.ParseKeyValues(keyValues) == SGEntityStringTokenizer::ParseResult::Error) {
+		Com_Error(ErrorType::Drop, "%s: %s", __func__, tokenizer.GetErrorString());
+		return false;
+	}
 
+	for (const SGEntityKeyValue &keyValue : keyValues) {
 		// keynames with a leading underscore are used for utility comments,
 		// and are immediately discarded by quake
-		if (key[0] == '_') {
+		if (!keyValue.key.empty() && keyValue.key[0] == '_') {
 			continue;
 		}
 
-		// Insert the key/value into the dictionary.
-		parsedKeyValues.try_emplace(std::string(key),std::string(value));// = value;
+		// Insert the key/value into the dictionary, the first occurrence of a key wins.
+		parsedKeyValues.emplace(keyValue.key, keyValue.value);
 	}
 
-	// Return the result.
-	return parsedSuccessfully;
+	// We successfully managed to parse this entity if it had any key/values.
+	return !keyValues.empty();
 }
 
 /**
@@ -544,20 +524,21 @@ qboolean ServerGameWorld::CreateGameEntityFromDictionary(PODEntity *podEntity, S
     int32_t stateNumber = podEntity->currentState.number;
 
 	// It needs the classname key, as well as it needs to have a value for it, how else can we spawn a game entity?
-    if (!dictionary.contains("classname") || dictionary["classname"].empty()) {
+    auto classnameEntry = dictionary.find("classname");
+    if (classnameEntry == dictionary.end() || classnameEntry->second.empty()) {
 		// For the server game we error out in this case, it can't go on since it is the actual game master.
 		gi.Error("SVGWarning: Can't spawn ServerGameEntity for PODEntity(#%i) due to a missing 'classname' key/value.\n", stateNumber);
 		return false;
     }
 
 	// Actually spawn the game entity.
-    IServerGameEntity *gameEntity = CreateGameEntityFromClassname(podEntity, dictionary["classname"]);
+    IServerGameEntity *gameEntity = CreateGameEntityFromClassname(podEntity, classnameEntry->second);
 
     // Something went wrong with allocating the game entity.
     if (!gameEntity) {
 		// Free/reset the PODEntity for reusal.
 		//FreePODEntity(podEntity);
-		gi.DPrintf("SVGWarning: Spawning entity(%s) failed.\n", dictionary["classname"].c_str());
+		gi.DPrintf("SVGWarning: Spawning entity(%s) failed.\n", classnameEntry->second.c_str());
 		return false;
     }
 
@@ -191,6 +191,13 @@ public:
 	    return &podEntities[index];
     }
 
+    /**
+	*	@return	The hot simulation fields store of all game entities.
+	**/
+    inline EntityHotStates &GetEntityHotStates() {
+        return entityHotStates;
+    }
+
     /**
 	*	@return	A pointer to the class entities array.
 	**/
@@ -272,6 +279,12 @@ private:
     //! Total number of actively spawned entities.
     int32_t numberOfEntities = 0;
 
+    //! Hot simulation fields of all game entities, see EntityHotStates.h
+    EntityHotStates entityHotStates = {};
+
+    //! Key/values of the entity being parsed by ParseEntityString.
+    std::vector<SGEntityKeyValue> entityKeyValues;
+
 
     /**
     *   @brief Nothing yet.
@@ -297,7 +310,7 @@ private:
 	*			entity dictionary.
 	*	@return	True in case it succeeded parsing the entity string.
 	**/
-    qboolean ParseEntityString(const char** data, SpawnKeyValues &parsedKeyValues);
+    qboolean ParseEntityString(SGEntityStringTokenizer &tokenizer, SpawnKeyValues &parsedKeyValues);
 
     /**
     *   @brief  Allocates the game entity determined by the classname key, and
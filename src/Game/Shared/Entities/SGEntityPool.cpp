@@ -0,0 +1,185 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Game Entity Pools implementation.
+*
+***/
+#include "../SharedGame.h"
+#include "../Entities.h"
+
+#include "SGEntityPool.h"
+
+
+
+/**
+*
+*
+*	SGEntityPool.
+*
+*
+**/
+//! Alignment of each pooled object.
+static constexpr size_t SG_ENTITYPOOL_ALIGNMENT = alignof( std::max_align_t );
+
+SGEntityPool::SGEntityPool( const size_t objectSize ) {
+	// Round up to keep every object in a chunk aligned, and large enough for the free list node.
+	const size_t minimumSize = ( objectSize > sizeof( FreeObject ) ? objectSize : sizeof( FreeObject ) );
+	this->objectSize = ( minimumSize + SG_ENTITYPOOL_ALIGNMENT - 1 ) & ~( SG_ENTITYPOOL_ALIGNMENT - 1 );
+}
+
+SGEntityPool::~SGEntityPool() {
+	for ( void *chunk : chunks ) {
+		::operator delete( chunk );
+	}
+}
+
+/**
+*	@return	Memory for a single object, taken from the free list.
+**/
+void *SGEntityPool::Allocate() {
+	if ( !freeList ) {
+		AllocateChunk();
+	}
+
+	FreeObject *object = freeList;
+	freeList = object->next;
+	numAllocated++;
+
+	return object;
+}
+
+/**
+*	@brief	Puts the object's memory back on the free list.
+**/
+void SGEntityPool::Free( void *memory ) {
+	if ( !memory ) {
+		return;
+	}
+
+	FreeObject *object = static_cast<FreeObject*>( memory );
+	object->next = freeList;
+	freeList = object;
+	numAllocated--;
+}
+
+/**
+*	@brief	Frees all chunks if none of their objects are in use.
+*	@return	True if the chunks were released.
+**/
+const bool SGEntityPool::ReleaseChunks() {
+	if ( numAllocated ) {
+		return false;
+	}
+
+	for ( void *chunk : chunks ) {
+		::operator delete( chunk );
+	}
+	chunks.clear();
+	freeList = nullptr;
+
+	return true;
+}
+
+/**
+*	@brief	Allocates a new chunk and puts its objects on the free list.
+**/
+void SGEntityPool::AllocateChunk() {
+	uint8_t *chunk = static_cast<uint8_t*>( ::operator new( objectSize * ObjectsPerChunk ) );
+	chunks.push_back( chunk );
+
+	// Link them up back to front, so allocations walk the chunk in order.
+	for ( size_t i = ObjectsPerChunk; i-- > 0; ) {
+		FreeObject *object = reinterpret_cast<FreeObject*>( chunk + i * objectSize );
+		object->next = freeList;
+		freeList = object;
+	}
+}
+
+
+
+/**
+*
+*
+*	SGEntityPoolAllocator.
+*
+*
+**/
+SGEntityPoolAllocator::~SGEntityPoolAllocator() {
+	for ( SGEntityPool *pool : pools ) {
+		delete pool;
+	}
+}
+
+/**
+*	@return	Memory for an object of the given class. Objects whose size doesn't match the
+*			class' pool (A derived class without its own type info) use operator new instead.
+**/
+void *SGEntityPoolAllocator::Allocate( const TypeInfo &typeInfo, const size_t size ) {
+	const size_t classID = typeInfo.classInfoID.GetID();
+	if ( classID >= pools.size() ) {
+		pools.resize( classID + 1, nullptr );
+	}
+
+	// The first allocation of a class determines its pool's object size.
+	if ( !pools[classID] ) {
+		pools[classID] = new SGEntityPool( size );
+	}
+
+	SGEntityPool *pool = pools[classID];
+	if ( size > pool->GetObjectSize() ) {
+		return ::operator new( size );
+	}
+
+	return pool->Allocate();
+}
+
+/**
+*	@brief	Frees memory that was allocated for an object of the given class.
+**/
+void SGEntityPoolAllocator::Free( const TypeInfo &typeInfo, void *memory, const size_t size ) {
+	if ( !memory ) {
+		return;
+	}
+
+	// Same decision as Allocate made.
+	const size_t classID = typeInfo.classInfoID.GetID();
+	SGEntityPool *pool = ( classID < pools.size() ? pools[classID] : nullptr );
+	if ( !pool || size > pool->GetObjectSize() ) {
+		::operator delete( memory );
+		return;
+	}
+
+	pool->Free( memory );
+}
+
+/**
+*	@brief	Releases the chunks of every pool that has no objects in use.
+**/
+void SGEntityPoolAllocator::ReleaseUnusedChunks() {
+	for ( SGEntityPool *pool : pools ) {
+		if ( pool ) {
+			pool->ReleaseChunks();
+		}
+	}
+}
+
+/**
+*	@return	The game module's game entity pool allocator.
+**/
+SGEntityPoolAllocator &SG_GetEntityPoolAllocator() {
+	static SGEntityPoolAllocator entityPoolAllocator;
+	return entityPoolAllocator;
+}
+
+/**
+*	@brief	Used by the TypeInfo macros for operator new/delete.
+**/
+void *SG_AllocateGameEntityMemory( const TypeInfo &typeInfo, const size_t size ) {
+	return SG_GetEntityPoolAllocator().Allocate( typeInfo, size );
+}
+void SG_FreeGameEntityMemory( const TypeInfo &typeInfo, void *memory, const size_t size ) {
+	SG_GetEntityPoolAllocator().Free( typeInfo, memory, size );
+}
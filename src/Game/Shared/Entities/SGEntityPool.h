@@ -0,0 +1,109 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Game Entity Pools: Per class free list allocators for game entities. Objects of the same
+*	class are packed together in chunks, and freed objects are handed out again by the next
+*	allocation instead of going back to the system allocator.
+* 
+*	The TypeInfo macros route operator new/delete of each game entity class to the pool of
+*	its class. The game world releases the unused chunks in bulk on level change.
+*
+***/
+#pragma once
+
+// Predeclare.
+class TypeInfo;
+
+
+
+/**
+*	@brief	Fixed object size free list allocator, grows a chunk at a time.
+**/
+class SGEntityPool {
+public:
+	//! Amount of objects per chunk.
+	static constexpr size_t ObjectsPerChunk = 64;
+
+	SGEntityPool( const size_t objectSize );
+	~SGEntityPool();
+
+	// Not copyable, the free list points into our chunks.
+	SGEntityPool( const SGEntityPool & ) = delete;
+	SGEntityPool &operator=( const SGEntityPool & ) = delete;
+
+	/**
+	*	@return	Memory for a single object, taken from the free list.
+	**/
+	void *Allocate();
+	/**
+	*	@brief	Puts the object's memory back on the free list.
+	**/
+	void Free( void *memory );
+	/**
+	*	@brief	Frees all chunks if none of their objects are in use.
+	*	@return	True if the chunks were released.
+	**/
+	const bool ReleaseChunks();
+
+	const size_t GetObjectSize() const { return objectSize; }
+	const size_t GetNumAllocated() const { return numAllocated; }
+	const size_t GetNumChunks() const { return chunks.size(); }
+
+private:
+	//! Intrusive free list node, lives in the memory of a free object.
+	struct FreeObject {
+		FreeObject *next;
+	};
+
+	//! Allocates a new chunk and puts its objects on the free list.
+	void AllocateChunk();
+
+	//! Object size, rounded up to keep each object aligned.
+	size_t objectSize = 0;
+	//! Chunk memory.
+	std::vector<void*> chunks;
+	//! First free object.
+	FreeObject *freeList = nullptr;
+	//! Objects currently handed out.
+	size_t numAllocated = 0;
+};
+
+/**
+*	@brief	Owns one SGEntityPool for each game entity class.
+**/
+class SGEntityPoolAllocator {
+public:
+	~SGEntityPoolAllocator();
+
+	/**
+	*	@return	Memory for an object of the given class. Objects whose size doesn't match the
+	*			class' pool (A derived class without its own type info) use operator new instead.
+	**/
+	void *Allocate( const TypeInfo &typeInfo, const size_t size );
+	/**
+	*	@brief	Frees memory that was allocated for an object of the given class.
+	**/
+	void Free( const TypeInfo &typeInfo, void *memory, const size_t size );
+	/**
+	*	@brief	Releases the chunks of every pool that has no objects in use.
+	**/
+	void ReleaseUnusedChunks();
+
+private:
+	//! Pools, indexed by class ID.
+	std::vector<SGEntityPool*> pools;
+};
+
+/**
+*	@return	The game module's game entity pool allocator.
+**/
+SGEntityPoolAllocator &SG_GetEntityPoolAllocator();
+
+/**
+*	@brief	Used by the TypeInfo macros for operator new/delete.
+**/
+void *SG_AllocateGameEntityMemory( const TypeInfo &typeInfo, const size_t size );
+void SG_FreeGameEntityMemory( const TypeInfo &typeInfo, void *memory, const size_t size );
@@ -19,6 +19,9 @@
 // Required include here.
 #include <string>
 
+// Game Entity Pools.
+#include "SGEntityPool.h"
+
 
 
 /**
@@ -71,6 +74,7 @@ public:
 		prev = head;
 		head = this;
 		hashedMapClass = HashClassnameString(mapClassName, strlen(mapClassName), 64);
+		hashedClassname = HashClassnameString(entClassName, strlen(entClassName), 64);
 
 		// Doesn't actually quite work here, so I wrote SetupSuperClasses
 		super = GetInfoByName( superClassName );
@@ -87,6 +91,13 @@ public:
 
 	// Is this entity a subclass of this class?
 	bool IsSubclassOf( const TypeInfo& eci ) const {
+		// Single bit test once SetupSuperClasses has built the ancestor bits.
+		if ( !ancestorBits.empty() ) {
+			const size_t classID = eci.classInfoID.GetID();
+			const size_t wordIndex = classID >> 6;
+			return wordIndex < ancestorBits.size() && ( ancestorBits[wordIndex] >> ( classID & 63 ) ) & 1;
+		}
+
 		if ( nullptr == super )
 			return false;
 
@@ -138,6 +149,18 @@ public:
 			return nullptr;
 		}
 
+		// Use the look-up table if it has been built already.
+		if ( !mapClassTable.empty() ) {
+			const uint32_t hashedName = HashClassnameString( name, strlen( name ), 64 );
+			for ( size_t slot = hashedName & ( mapClassTable.size() - 1 ); mapClassTable[slot]; slot = ( slot + 1 ) & ( mapClassTable.size() - 1 ) ) {
+				TypeInfo *current = mapClassTable[slot];
+				if ( current->hashedMapClass == hashedName && !strcmp( current->mapClass, name ) ) {
+					return current;
+				}
+			}
+			return nullptr;
+		}
+
 		TypeInfo* current = nullptr;
 		current = head;
 
@@ -157,6 +180,16 @@ public:
 			return nullptr;
 		}
 
+		// Use the look-up table if it has been built already.
+		if ( !mapClassTable.empty() ) {
+			for ( size_t slot = hashedName & ( mapClassTable.size() - 1 ); mapClassTable[slot]; slot = ( slot + 1 ) & ( mapClassTable.size() - 1 ) ) {
+				if ( mapClassTable[slot]->hashedMapClass == hashedName ) {
+					return mapClassTable[slot];
+				}
+			}
+			return nullptr;
+		}
+
 		TypeInfo* current = nullptr;
 		current = head;
 
@@ -176,6 +209,18 @@ public:
 			return nullptr;
 		}
 
+		// Use the look-up table if it has been built already.
+		if ( !classnameTable.empty() ) {
+			const uint32_t hashedName = HashClassnameString( name, strlen( name ), 64 );
+			for ( size_t slot = hashedName & ( classnameTable.size() - 1 ); classnameTable[slot]; slot = ( slot + 1 ) & ( classnameTable.size() - 1 ) ) {
+				TypeInfo *current = classnameTable[slot];
+				if ( current->hashedClassname == hashedName && !strcmp( current->classname, name ) ) {
+					return current;
+				}
+			}
+			return nullptr;
+		}
+
 		TypeInfo* current = nullptr;
 		current = head;
 
@@ -189,8 +234,13 @@ public:
 		return nullptr;
 	}
 
-	// This is called during game initialisation to properly set all superclasses
+	// This is called during game initialisation to properly set all superclasses, and
+	// build the look-up tables and ancestor bits.
 	static void SetupSuperClasses() {
+		// Throw away the old tables so the look-ups below walk the list.
+		mapClassTable.clear();
+		classnameTable.clear();
+
 		TypeInfo* current = nullptr;
 		current = head;
 
@@ -198,18 +248,61 @@ public:
 			current->super = GetInfoByName( current->superName );
 			current = current->prev;
 		}
+
+		// Open addressed tables, at most half full. Filled in list order so that on duplicate
+		// names the look-ups return the same class as the list walk does.
+		size_t tableSize = 16;
+		while ( tableSize < StaticCounter::GlobalID * 2 ) {
+			tableSize <<= 1;
+		}
+		std::vector<TypeInfo*> newMapClassTable( tableSize, nullptr );
+		std::vector<TypeInfo*> newClassnameTable( tableSize, nullptr );
+
+		// Each class gets one bit per class it counts as a subclass of.
+		const size_t numAncestorWords = ( StaticCounter::GlobalID + 63 ) >> 6;
+
+		for ( current = head; current; current = current->prev ) {
+			size_t slot = current->hashedMapClass & ( tableSize - 1 );
+			while ( newMapClassTable[slot] ) {
+				slot = ( slot + 1 ) & ( tableSize - 1 );
+			}
+			newMapClassTable[slot] = current;
+
+			slot = current->hashedClassname & ( tableSize - 1 );
+			while ( newClassnameTable[slot] ) {
+				slot = ( slot + 1 ) & ( tableSize - 1 );
+			}
+			newClassnameTable[slot] = current;
+
+			// Same outcome as the recursive walk: itself and its ancestors, except for
+			// the top class of the tree, which has no super.
+			current->ancestorBits.assign( numAncestorWords, 0 );
+			for ( TypeInfo *ancestor = current; ancestor && ancestor->super; ancestor = ancestor->super ) {
+				const size_t classID = ancestor->classInfoID.GetID();
+				current->ancestorBits[classID >> 6] |= ( 1ULL << ( classID & 63 ) );
+			}
+		}
+
+		mapClassTable = std::move( newMapClassTable );
+		classnameTable = std::move( newClassnameTable );
 	}
 
 	TypeInfo*       prev;
 	inline static TypeInfo* head = nullptr;
 
+	// Hashed look-up tables, built by SetupSuperClasses. Empty until then.
+	inline static std::vector<TypeInfo*> mapClassTable;
+	inline static std::vector<TypeInfo*> classnameTable;
+	// One bit for each class ID this class is a subclass of, built by SetupSuperClasses.
+	std::vector<uint64_t> ancestorBits;
+
 	StaticCounter   classInfoID; // automatically increments itself; TODO: maybe generate a CRC32 for each classname instead?
 	TypeInfo*       super;
 
 	const char*     mapClass;
 	uint32_t		hashedMapClass;
 	const char*     classname;
-	//uint32_t		hashedClassname;
+	uint32_t		hashedClassname;
 	const char*     superName;
 	uint8_t			typeFlags;
 };
@@ -220,12 +313,19 @@ public:
 // ========================================================================
 
 // Declares and initialises the type information for a class 
+// Instances are allocated from the class' own entity pool, see SGEntityPool.h
 // @param mapClassName - the map classname of this entity, used during entity spawning 
 // @param classname - the internal C++ class name 
 #define __DeclareTypeInfo( mapClassName, classname, superClass, typeFlags, allocatorFunction )	\
 virtual inline TypeInfo* GetTypeInfo() const {					\
 	return &ClassInfo;											\
 }																\
+static inline void* operator new( size_t size ) {				\
+	return SG_AllocateGameEntityMemory( ClassInfo, size );		\
+}																\
+static inline void operator delete( void *memory, size_t size ) {	\
+	SG_FreeGameEntityMemory( ClassInfo, memory, size );		\
+}																\
 inline static TypeInfo ClassInfo = TypeInfo( (mapClassName), (classname), (superClass), (typeFlags), (allocatorFunction) );
 
 // Top abstract class, the start of the class tree 
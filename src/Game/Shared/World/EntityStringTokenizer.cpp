@@ -0,0 +1,115 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Entity String Tokenizer implementation.
+*
+***/
+#include "../SharedGame.h"
+
+#include "EntityStringTokenizer.h"
+
+
+
+/**
+*	@brief	Parses the next token.
+*	@return	False if the end of the string has been reached.
+**/
+const bool SGEntityStringTokenizer::NextToken( std::string_view &token ) {
+	token = {};
+
+	if ( !data ) {
+		return false;
+	}
+
+	// Skip whitespace and comments.
+	while ( true ) {
+		while ( (unsigned char)*data <= ' ' ) {
+			if ( !*data ) {
+				data = nullptr;
+				return false;
+			}
+			data++;
+		}
+
+		// Skip // comments.
+		if ( data[0] == '/' && data[1] == '/' ) {
+			data += 2;
+			while ( *data && *data != '\n' ) {
+				data++;
+			}
+			continue;
+		}
+
+		// Skip /* */ comments.
+		if ( data[0] == '/' && data[1] == '*' ) {
+			data += 2;
+			while ( *data && !( data[0] == '*' && data[1] == '/' ) ) {
+				data++;
+			}
+			if ( *data ) {
+				data += 2;
+			}
+			continue;
+		}
+
+		break;
+	}
+
+	// Quoted strings run up to the closing quote.
+	if ( *data == '\"' ) {
+		const char *start = ++data;
+		while ( *data && *data != '\"' ) {
+			data++;
+		}
+		token = std::string_view( start, data - start );
+		if ( *data ) {
+			data++;
+		}
+		return true;
+	}
+
+	// Regular words run up to the next whitespace.
+	const char *start = data;
+	while ( (unsigned char)*data > ' ' ) {
+		data++;
+	}
+	token = std::string_view( start, data - start );
+
+	return true;
+}
+
+/**
+*	@brief	Parses key/values up to, and including the closing brace of the current entity.
+*			Key/values are appended to keyValues in the order they appear in.
+**/
+const SGEntityStringTokenizer::ParseResult SGEntityStringTokenizer::ParseKeyValues( std::vector<SGEntityKeyValue> &keyValues ) {
+	std::string_view key, value;
+
+	while ( true ) {
+		// Parse the key, a } means we're done with this entity.
+		if ( !NextToken( key ) ) {
+			errorString = "EOF without closing brace";
+			return ParseResult::Error;
+		}
+		if ( !key.empty() && key[0] == '}' ) {
+			break;
+		}
+
+		// Parse the value.
+		if ( !NextToken( value ) ) {
+			errorString = "EOF without closing brace";
+			return ParseResult::Error;
+		}
+		if ( !value.empty() && value[0] == '}' ) {
+			errorString = "closing brace without value for key " + std::string( key );
+			return ParseResult::Error;
+		}
+
+		keyValues.push_back( { key, value } );
+	}
+
+	return ParseResult::Parsed;
+}
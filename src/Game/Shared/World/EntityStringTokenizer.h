@@ -0,0 +1,62 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Entity String Tokenizer: Single pass tokenizer for the BSP entity lump. Tokens are handed
+*	out as string views into the lump itself, nothing is copied until the world builds the
+*	actual spawn dictionaries. Follows the same rules as COM_Parse. (Whitespace, C and C++
+*	comments, and quoted strings.)
+*
+***/
+#pragma once
+
+
+
+/**
+*	@brief	A single key/value pair, pointing into the entity string.
+**/
+struct SGEntityKeyValue {
+	std::string_view key;
+	std::string_view value;
+};
+
+/**
+*	@brief	Tokenizes the entity string one token, or entity at a time.
+**/
+class SGEntityStringTokenizer {
+public:
+	//! ParseKeyValues results.
+	enum class ParseResult {
+		//! An entity was parsed.
+		Parsed,
+		//! The entity string is malformed, see GetErrorString.
+		Error
+	};
+
+	SGEntityStringTokenizer( const char *entityString ) : data( entityString ) {}
+
+	/**
+	*	@brief	Parses the next token.
+	*	@return	False if the end of the string has been reached.
+	**/
+	const bool NextToken( std::string_view &token );
+
+	/**
+	*	@brief	Parses key/values up to, and including the closing brace of the current entity.
+	*			Key/values are appended to keyValues in the order they appear in.
+	**/
+	const ParseResult ParseKeyValues( std::vector<SGEntityKeyValue> &keyValues );
+
+	/**
+	*	@return	Description of the last error.
+	**/
+	const char *GetErrorString() const { return errorString.c_str(); }
+
+private:
+	//! Current position in the entity string, nullptr once we've reached its end.
+	const char *data = nullptr;
+	//! Last error.
+	std::string errorString;
+};
@@ -12,6 +12,9 @@
 ***/
 #pragma once
 
+// Entity String Tokenizer.
+#include "EntityStringTokenizer.h"
+
 // Predefine.
 class SGEntityHandle;
 class ISharedGameEntity;
@@ -309,7 +312,7 @@ protected:
 	*			entity dictionary.
 	*	@return	True in case it succeeded parsing the entity string.
 	**/
-    virtual qboolean ParseEntityString(const char** data, SpawnKeyValues &parsedKeyValues) = 0;
+    virtual qboolean ParseEntityString(SGEntityStringTokenizer &tokenizer, SpawnKeyValues &parsedKeyValues) = 0;
 
     /**
     *   @brief  Allocates the game entity determined by the classname key, and
@@ -115,6 +115,11 @@ void IMG_Init(void);
 void IMG_Shutdown(void);
 void IMG_GetPalette(void);
 
+// TGA/JPG/PNG images are decoded in the background, see images.cpp
+void IMG_FinishPending(image_t *image);
+void IMG_FinishAllPending(void);
+void IMG_UpdatePending(void);
+
 image_t *IMG_ForHandle(qhandle_t h);
 
 qerror_t IMG_GetDimensions(const char* name, int* width, int* height);
@@ -123,6 +128,36 @@ void IMG_ResampleTexture(const byte *in, int inwidth, int inheight,
                          byte *out, int outwidth, int outheight);
 void IMG_MipMap(byte *out, byte *in, int width, int height);
 
+// sRGB <-> linear lookup tables, filled in by IMG_Init
+#define IMG_SRGB_ENCODE_SIZE    8192
+
+extern float    img_srgbToLinear[256];
+extern byte     img_linearToSrgb[IMG_SRGB_ENCODE_SIZE];
+extern float    img_srgbThresholds[255];
+
+static inline float IMG_DecodeSRGB(byte pix)
+{
+    return img_srgbToLinear[pix];
+}
+
+// Gives the same result as encoding with powf: the table is only off by one
+// close to where the output steps, which the thresholds correct.
+static inline byte IMG_EncodeSRGB(float x)
+{
+    int b;
+
+    x = max(0.f, min(1.f, x));
+    b = img_linearToSrgb[(int)(x * (IMG_SRGB_ENCODE_SIZE - 1) + 0.5f)];
+
+    if (b < 255 && x >= img_srgbThresholds[b]) {
+        b++;
+    } else if (b > 0 && x < img_srgbThresholds[b - 1]) {
+        b--;
+    }
+
+    return b;
+}
+
 // these are implemented in src/refresh/[gl,sw]/images.c
 extern void (*IMG_Unload)(image_t *image);
 extern void (*IMG_Load)(image_t *image, byte *pic);
@@ -54,6 +54,16 @@ qhandle_t R_RegisterRawImage(const char *name, int width, int height, byte* pic,
                           imageflags_t flags);
 void R_UnregisterImage(qhandle_t handle);
 
+// decodes an image file without uploading it, for the imagetest command
+qerror_t IMG_TestDecode(const char *name);
+
+#if USE_TESTS
+// mipmap, resample and srgb, timed by the imagebench command
+#define IMG_BENCH_KERNELS   3
+
+qerror_t IMG_Benchmark(const char *name, double times[2][IMG_BENCH_KERNELS]);
+#endif
+
 extern void    (*R_SetSky)(const char *name, float rotate, vec3_t &axis);
 extern void    (*R_EndRegistration)(const char *name);
 
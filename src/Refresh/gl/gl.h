@@ -52,6 +52,9 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #define MAX_TMUS        2
 
+// surfaces mark the lights that touch them in a 32 bit mask
+#define GL_MAX_DLIGHTS  32
+
 #define TAB_SIN(x) gl_static.sintab[(x) & 255]
 #define TAB_COS(x) gl_static.sintab[((x) + 64) & 255]
 
@@ -568,6 +568,8 @@ void R_RenderFrame_GL(refdef_t *fd)
 
     if (gl_dynamic->integer != 1 || gl_vertexlight->integer) {
         glr.fd.num_dlights = 0;
+    } else if (glr.fd.num_dlights > GL_MAX_DLIGHTS) {
+        glr.fd.num_dlights = GL_MAX_DLIGHTS;
     }
 
     if (lm.dirty) {
@@ -623,6 +625,9 @@ void R_BeginFrame_GL(void)
 
     memset(&c, 0, sizeof(c));
 
+    // upload textures the decode threads have finished
+    IMG_UpdatePending();
+
     if (gl_finish->integer) {
         qglFinish();
     }
@@ -413,6 +413,7 @@ void R_SetSky_GL(const char *name, float rotate, vec3_t &axis)
         }
         FS_NormalizePath(pathname, pathname);
         image = IMG_Find(pathname, IT_SKY, IF_NONE);
+        IMG_FinishPending(image);
         if (image->texnum == TEXNUM_DEFAULT) {
             R_UnsetSky();
             return;
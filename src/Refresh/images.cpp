@@ -33,6 +33,16 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include "stb_image_write.h"
 #include "Client/Models.h"
 #include <assert.h>
+#include <chrono>
+#include <deque>
+#include <mutex>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define USE_SSE2    1
+#include <emmintrin.h>
+#else
+#define USE_SSE2    0
+#endif
 
 #define R_COLORMAP_PCX    "pics/colormap.pcx"
 
@@ -637,6 +647,135 @@ IMAGE PROCESSING
 =========================================================
 */
 
+#if USE_TESTS
+// the imagebench command switches the SIMD kernels off to time the plain C loops
+static qboolean img_simd = true;
+#define IMG_SIMD    img_simd
+#else
+#define IMG_SIMD    true
+#endif
+
+float   img_srgbToLinear[256];
+byte    img_linearToSrgb[IMG_SRGB_ENCODE_SIZE];
+float   img_srgbThresholds[255];  // smallest linear value that encodes to i + 1
+
+static float IMG_DecodeSRGBExact(byte pix)
+{
+    float x = (float)pix / 255.f;
+
+    if (x < 0.04045f)
+        return x / 12.92f;
+
+    return powf((x + 0.055f) / 1.055f, 2.4f);
+}
+
+static byte IMG_EncodeSRGBExact(float x)
+{
+    if (x <= 0.0031308f)
+        x *= 12.92f;
+    else
+        x = 1.055f * powf(x, 1.f / 2.4f) - 0.055f;
+
+    x = max(0.f, min(1.f, x));
+
+    return (byte)roundf(x * 255.f);
+}
+
+static void IMG_InitSRGBTables(void)
+{
+    int i;
+
+    for (i = 0; i < 256; i++) {
+        img_srgbToLinear[i] = IMG_DecodeSRGBExact(i);
+    }
+
+    for (i = 0; i < IMG_SRGB_ENCODE_SIZE; i++) {
+        img_linearToSrgb[i] = IMG_EncodeSRGBExact((float)i / (IMG_SRGB_ENCODE_SIZE - 1));
+    }
+
+    // find each step of the exact encoding by bisecting over the bit patterns
+    // of the floats in [0, 1], which sort the same as the values themselves
+    for (i = 0; i < 255; i++) {
+        uint32_t lo = 0, hi, mid;
+        float one = 1.f, x;
+
+        memcpy(&hi, &one, sizeof(hi));
+        while (lo < hi) {
+            mid = lo + (hi - lo) / 2;
+            memcpy(&x, &mid, sizeof(x));
+            if (IMG_EncodeSRGBExact(x) > i) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        memcpy(&img_srgbThresholds[i], &lo, sizeof(float));
+    }
+
+#ifdef _DEBUG
+    // the table has to agree with powf on both sides of every step
+    for (i = 0; i < 255; i++) {
+        uint32_t bits;
+        float x = img_srgbThresholds[i], below;
+
+        memcpy(&bits, &x, sizeof(bits));
+        bits--;
+        memcpy(&below, &bits, sizeof(below));
+
+        if (IMG_EncodeSRGB(x) != IMG_EncodeSRGBExact(x) || IMG_EncodeSRGB(below) != IMG_EncodeSRGBExact(below)) {
+            Com_EPrintf("%s: sRGB encode table is off at %d\n", __func__, i + 1);
+            break;
+        }
+    }
+#endif
+}
+
+#if USE_SSE2
+// averages 2x2 blocks of four RGBA pixels from each row into 4 output pixels
+static inline void IMG_ResamplePixels_SSE2(byte *out, __m128i a, __m128i b, __m128i c, __m128i d)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo, hi;
+
+    lo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)),
+                       _mm_add_epi16(_mm_unpacklo_epi8(c, zero), _mm_unpacklo_epi8(d, zero)));
+    hi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)),
+                       _mm_add_epi16(_mm_unpackhi_epi8(c, zero), _mm_unpackhi_epi8(d, zero)));
+
+    _mm_storeu_si128((__m128i *)out, _mm_packus_epi16(_mm_srli_epi16(lo, 2), _mm_srli_epi16(hi, 2)));
+}
+
+static inline int IMG_LoadPixel(const byte *p)
+{
+    int v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// 8 pixels from each of two rows down to 4
+static inline void IMG_MipMap8_SSE2(byte *out, const byte *in, const byte *in2)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a0 = _mm_loadu_si128((const __m128i *)in);
+    __m128i a1 = _mm_loadu_si128((const __m128i *)(in + 16));
+    __m128i b0 = _mm_loadu_si128((const __m128i *)in2);
+    __m128i b1 = _mm_loadu_si128((const __m128i *)(in2 + 16));
+    __m128i s0, s1, s2, s3, t0, t1;
+
+    // vertical sums, two pixels per register
+    s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+    s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+    s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+    s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+    // horizontal sums of neighbouring pixels
+    t0 = _mm_add_epi16(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+    t1 = _mm_add_epi16(_mm_unpacklo_epi64(s2, s3), _mm_unpackhi_epi64(s2, s3));
+
+    _mm_storeu_si128((__m128i *)out, _mm_packus_epi16(_mm_srli_epi16(t0, 2), _mm_srli_epi16(t1, 2)));
+}
+#endif
+
 void IMG_ResampleTexture(const byte *in, int inwidth, int inheight,
                          byte *out, int outwidth, int outheight)
 {
@@ -669,7 +808,21 @@ void IMG_ResampleTexture(const byte *in, int inwidth, int inheight,
     for (i = 0; i < outheight; i++) {
         inrow1 = in + inwidth * (int)((i + 0.25f) * heightScale);
         inrow2 = in + inwidth * (int)((i + 0.75f) * heightScale);
-        for (j = 0; j < outwidth; j++) {
+        j = 0;
+#if USE_SSE2
+        for (; IMG_SIMD && j + 4 <= outwidth; j += 4, out += 16) {
+            IMG_ResamplePixels_SSE2(out,
+                _mm_setr_epi32(IMG_LoadPixel(inrow1 + p1[j]), IMG_LoadPixel(inrow1 + p1[j + 1]),
+                               IMG_LoadPixel(inrow1 + p1[j + 2]), IMG_LoadPixel(inrow1 + p1[j + 3])),
+                _mm_setr_epi32(IMG_LoadPixel(inrow1 + p2[j]), IMG_LoadPixel(inrow1 + p2[j + 1]),
+                               IMG_LoadPixel(inrow1 + p2[j + 2]), IMG_LoadPixel(inrow1 + p2[j + 3])),
+                _mm_setr_epi32(IMG_LoadPixel(inrow2 + p1[j]), IMG_LoadPixel(inrow2 + p1[j + 1]),
+                               IMG_LoadPixel(inrow2 + p1[j + 2]), IMG_LoadPixel(inrow2 + p1[j + 3])),
+                _mm_setr_epi32(IMG_LoadPixel(inrow2 + p2[j]), IMG_LoadPixel(inrow2 + p2[j + 1]),
+                               IMG_LoadPixel(inrow2 + p2[j + 2]), IMG_LoadPixel(inrow2 + p2[j + 3])));
+        }
+#endif
+        for (; j < outwidth; j++) {
             pix1 = inrow1 + p1[j];
             pix2 = inrow1 + p2[j];
             pix3 = inrow2 + p1[j];
@@ -683,6 +836,7 @@ void IMG_ResampleTexture(const byte *in, int inwidth, int inheight,
     }
 }
 
+// out may be the same as in, rows are only ever written behind the reads
 void IMG_MipMap(byte *out, byte *in, int width, int height)
 {
     int     i, j;
@@ -690,7 +844,13 @@ void IMG_MipMap(byte *out, byte *in, int width, int height)
     width <<= 2;
     height >>= 1;
     for (i = 0; i < height; i++, in += width) {
-        for (j = 0; j < width; j += 8, out += 4, in += 8) {
+        j = 0;
+#if USE_SSE2
+        for (; IMG_SIMD && j + 32 <= width; j += 32, out += 16, in += 32) {
+            IMG_MipMap8_SSE2(out, in, in + width);
+        }
+#endif
+        for (; j < width; j += 8, out += 4, in += 8) {
             out[0] = (in[0] + in[4] + in[width + 0] + in[width + 4]) >> 2;
             out[1] = (in[1] + in[5] + in[width + 1] + in[width + 5]) >> 2;
             out[2] = (in[2] + in[6] + in[width + 2] + in[width + 6]) >> 2;
@@ -732,6 +892,7 @@ static int              img_total;
 
 static cvar_t   *r_override_textures;
 static cvar_t   *r_texture_formats;
+static cvar_t   *r_texture_threads;
 
 /*
 ===============
@@ -847,6 +1008,500 @@ static image_t *lookup_image(const char *name,
     return NULL;
 }
 
+/*
+=========================================================
+
+BACKGROUND DECODING
+
+TGA, JPG and PNG files are read on the main thread, since the filesystem
+isn't thread safe, but decompressed by a small pool of worker threads.
+The image is registered right away with the dimensions from the file
+header and a placeholder texture; the real pixels are handed to IMG_Load
+once a worker is done with them.
+
+The zone allocator is main thread only, so jobs decode into the C heap and
+their pixels are moved into zone memory by IMG_CompleteDecode.
+
+=========================================================
+*/
+
+#define MAX_DECODE_THREADS  8
+
+typedef enum {
+    DECODE_QUEUED,
+    DECODE_RUNNING,
+    DECODE_DONE
+} decodestate_t;
+
+typedef struct {
+    image_t         *image;
+    imageformat_t   fmt;
+    byte            *rawdata;   // file contents, freed on the main thread
+    size_t          rawlen;
+    image_t         result;     // scratch copy the loader fills in
+    byte            *pic;       // C heap, see IMG_RunDecode
+    qerror_t        ret;
+    decodestate_t   state;
+} decodejob_t;
+
+static decodejob_t                  *img_decodes[MAX_RIMAGES];
+static int                          img_numDecodes;
+static std::deque<decodejob_t *>    img_decodeQueue;
+static std::mutex                   img_decodeMutex;
+static std::condition_variable      img_decodeWork;
+static std::condition_variable      img_decodeDone;
+static std::vector<std::thread>     img_decodeThreads;
+static qboolean                     img_decodeQuit;
+
+// only set while find_or_load_image is looking for a file
+static qboolean                     img_decodeAllowed;
+
+// finished jobs picked up by IMG_UpdatePending
+static decodejob_t                  *img_decodesDone[MAX_RIMAGES];
+
+// set in stb.cpp
+extern thread_local qboolean        stbi_use_system_heap;
+
+// Runs on any thread, so the decoder has to stay away from the zone.
+static void IMG_RunDecode(decodejob_t *job)
+{
+    stbi_use_system_heap = true;
+    job->pic = NULL;
+    job->ret = img_loaders[job->fmt].load(job->rawdata, job->rawlen, &job->result, &job->pic);
+    stbi_use_system_heap = false;
+}
+
+// Moves the decoded pixels into zone memory, as IMG_LoadSTB would have returned them.
+static byte *IMG_TakeDecodedPixels(decodejob_t *job)
+{
+    size_t size = (size_t)job->result.upload_width * job->result.upload_height * 4;
+    byte *pic = (byte *)Z_Malloc(size);
+
+    memcpy(pic, job->pic, size);
+    free(job->pic);
+    job->pic = NULL;
+
+    return pic;
+}
+
+static void IMG_DecodeThread(void)
+{
+    std::unique_lock<std::mutex> lock(img_decodeMutex);
+
+    while (1) {
+        img_decodeWork.wait(lock, [] { return img_decodeQuit || !img_decodeQueue.empty(); });
+        if (img_decodeQuit) {
+            break;
+        }
+
+        decodejob_t *job = img_decodeQueue.front();
+        img_decodeQueue.pop_front();
+        job->state = DECODE_RUNNING;
+
+        lock.unlock();
+        IMG_RunDecode(job);
+        lock.lock();
+
+        job->state = DECODE_DONE;
+        img_decodeDone.notify_all();
+    }
+}
+
+static void IMG_StartDecodeThreads(void)
+{
+    int i, count;
+
+    count = Cvar_ClampInteger(r_texture_threads, 0, MAX_DECODE_THREADS);
+
+    img_decodeQuit = false;
+    for (i = 0; i < count; i++) {
+        img_decodeThreads.emplace_back(IMG_DecodeThread);
+    }
+
+    if (count) {
+        Com_DPrintf("%s: %d image decode threads\n", __func__, count);
+    }
+}
+
+static void IMG_StopDecodeThreads(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(img_decodeMutex);
+        img_decodeQuit = true;
+    }
+    img_decodeWork.notify_all();
+
+    for (auto &thread : img_decodeThreads) {
+        thread.join();
+    }
+    img_decodeThreads.clear();
+}
+
+// Until the decoder is done the image shows the same thing as R_NOTEXTURE.
+static void IMG_SetPlaceholder(image_t *image, qboolean set)
+{
+#if REF_GL
+    image->texnum = set ? R_NOTEXTURE->texnum : 0;
+    image->sl = 0;
+    image->sh = 1;
+    image->tl = 0;
+    image->th = 1;
+#endif
+#if REF_VKPT
+    // textures without pixels are skipped by vkpt_textures_end_registration
+    image->pix_data = NULL;
+#endif
+}
+
+// Hands the file contents over to the decode threads.
+// Returns false if the image has to be decoded right away instead.
+static qboolean IMG_QueueDecode(imageformat_t fmt, image_t *image, byte *rawdata, size_t rawlen)
+{
+    decodejob_t *job;
+    int w, h, channels;
+
+    if (!img_decodeAllowed || img_decodeThreads.empty()) {
+        return false;
+    }
+
+    // 8-bit formats are cheap enough to unpack on the spot
+    if (img_loaders[fmt].load != IMG_LoadSTB) {
+        return false;
+    }
+
+    // the size has to be known right away, the header is enough for that
+    if (!stbi_info_from_memory(rawdata, rawlen, &w, &h, &channels)) {
+        return false;
+    }
+
+    image->upload_width = image->width = w;
+    image->upload_height = image->height = h;
+    if (channels == 3) {
+        image->flags = (imageflags_t)(image->flags | IF_OPAQUE);
+    }
+
+    job = (decodejob_t *)R_Mallocz(sizeof(*job));
+    job->image = image;
+    job->fmt = fmt;
+    job->rawdata = rawdata;
+    job->rawlen = rawlen;
+    job->result.type = image->type;
+    job->result.flags = image->flags;
+    job->state = DECODE_QUEUED;
+
+    img_decodes[image - r_images] = job;
+    img_numDecodes++;
+
+    {
+        std::lock_guard<std::mutex> lock(img_decodeMutex);
+        img_decodeQueue.push_back(job);
+    }
+    img_decodeWork.notify_one();
+
+    return true;
+}
+
+// Main thread only, the job must no longer be queued or running.
+static void IMG_CompleteDecode(decodejob_t *job, qboolean discard)
+{
+    image_t *image = job->image;
+
+    img_decodes[image - r_images] = NULL;
+    img_numDecodes--;
+
+    FS_FreeFile(job->rawdata);
+
+    if (discard || job->ret < 0) {
+        if (!discard) {
+            Com_EPrintf("Couldn't decode %s: %s\n", image->filepath, Q_ErrorString(job->ret));
+        }
+        free(job->pic);
+        IMG_SetPlaceholder(image, false);
+    } else {
+        image->upload_width = job->result.upload_width;
+        image->upload_height = job->result.upload_height;
+        IMG_Load(image, IMG_TakeDecodedPixels(job));
+    }
+
+    Z_Free(job);
+}
+
+// Takes the job of the given image away from the decode threads,
+// decoding it on the spot if nobody has started on it yet.
+static decodejob_t *IMG_WaitDecode(image_t *image)
+{
+    decodejob_t *job = img_decodes[image - r_images];
+
+    if (!job) {
+        return NULL;
+    }
+
+    std::unique_lock<std::mutex> lock(img_decodeMutex);
+
+    if (job->state == DECODE_QUEUED) {
+        auto it = std::find(img_decodeQueue.begin(), img_decodeQueue.end(), job);
+        img_decodeQueue.erase(it);
+        job->state = DECODE_RUNNING;
+
+        lock.unlock();
+        IMG_RunDecode(job);
+        lock.lock();
+
+        job->state = DECODE_DONE;
+    }
+
+    img_decodeDone.wait(lock, [job] { return job->state == DECODE_DONE; });
+
+    return job;
+}
+
+/*
+===============
+IMG_FinishPending
+
+Blocks until the pixels of the given image are available.
+===============
+*/
+void IMG_FinishPending(image_t *image)
+{
+    decodejob_t *job = IMG_WaitDecode(image);
+
+    if (job) {
+        IMG_CompleteDecode(job, false);
+    }
+}
+
+void IMG_FinishAllPending(void)
+{
+    int i;
+
+    for (i = 1; i < r_numImages && img_numDecodes; i++) {
+        IMG_FinishPending(&r_images[i]);
+    }
+}
+
+// Drops a pending decode, used before the image slot is freed.
+static void IMG_CancelPending(image_t *image)
+{
+    decodejob_t *job = IMG_WaitDecode(image);
+
+    if (job) {
+        IMG_CompleteDecode(job, true);
+    }
+}
+
+/*
+===============
+IMG_UpdatePending
+
+Uploads whatever the decode threads have finished so far. Called once per frame.
+===============
+*/
+void IMG_UpdatePending(void)
+{
+    int i, count = 0;
+
+    if (!img_numDecodes) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(img_decodeMutex);
+
+        for (i = 1; i < r_numImages; i++) {
+            if (img_decodes[i] && img_decodes[i]->state == DECODE_DONE) {
+                img_decodesDone[count++] = img_decodes[i];
+            }
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        IMG_CompleteDecode(img_decodesDone[i], false);
+    }
+}
+
+/*
+===============
+IMG_TestDecode
+
+Decodes a TGA, JPG or PNG file both on the spot and through the decode
+threads, and checks that both give the same pixels. Needs no renderer,
+used by the imagetest command.
+===============
+*/
+qerror_t IMG_TestDecode(const char *name)
+{
+    decodejob_t job;
+    image_t     image;
+    const char  *ext;
+    byte        *rawdata, *pic, *decoded;
+    ssize_t     rawlen;
+    qerror_t    ret;
+    size_t      size;
+    int         fmt;
+
+    ext = COM_FileExtension(name);
+    for (fmt = IM_TGA; fmt < IM_MAX; fmt++) {
+        if (*ext && !Q_stricmp(ext + 1, img_loaders[fmt].ext)) {
+            break;
+        }
+    }
+    if (fmt == IM_MAX) {
+        return Q_ERR_INVALID_PATH;
+    }
+
+    rawlen = FS_LoadFile(name, (void **)&rawdata);
+    if (!rawdata) {
+        return rawlen;
+    }
+
+    // decode on the spot, the way find_or_load_image falls back to
+    memset(&image, 0, sizeof(image));
+    pic = NULL;
+    ret = img_loaders[fmt].load(rawdata, rawlen, &image, &pic);
+    if (ret) {
+        FS_FreeFile(rawdata);
+        return ret;
+    }
+
+    // decode through a job, on a worker when there is one
+    memset(&job, 0, sizeof(job));
+    job.image = &image;
+    job.fmt = (imageformat_t)fmt;
+    job.rawdata = rawdata;
+    job.rawlen = rawlen;
+    job.state = DECODE_QUEUED;
+
+    if (img_decodeThreads.empty()) {
+        IMG_RunDecode(&job);
+        job.state = DECODE_DONE;
+    } else {
+        std::unique_lock<std::mutex> lock(img_decodeMutex);
+        img_decodeQueue.push_back(&job);
+        img_decodeWork.notify_one();
+        img_decodeDone.wait(lock, [&job] { return job.state == DECODE_DONE; });
+    }
+
+    FS_FreeFile(rawdata);
+
+    if (job.ret) {
+        Z_Free(pic);
+        free(job.pic);
+        return job.ret;
+    }
+
+    ret = Q_ERR_SUCCESS;
+    if (job.result.upload_width != image.upload_width || job.result.upload_height != image.upload_height
+        || (job.result.flags & IF_OPAQUE) != (image.flags & IF_OPAQUE)) {
+        ret = Q_ERR_INVALID_FORMAT;
+    }
+
+    if (!ret) {
+        size = (size_t)image.upload_width * image.upload_height * 4;
+        decoded = IMG_TakeDecodedPixels(&job);
+        if (memcmp(decoded, pic, size)) {
+            ret = Q_ERR_INVALID_FORMAT;
+        }
+        Z_Free(decoded);
+    } else {
+        free(job.pic);
+    }
+
+    Z_Free(pic);
+    return ret;
+}
+
+#if USE_TESTS
+/*
+===============
+IMG_Benchmark
+
+Times the mipmap, resample and sRGB kernels on an image file, once with the
+plain C loops and once with SIMD (the tables for sRGB), and adds the time in
+milliseconds to times[simd][kernel]. Used by the imagebench command.
+===============
+*/
+static double IMG_BenchmarkTime(void)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+qerror_t IMG_Benchmark(const char *name, double times[2][IMG_BENCH_KERNELS])
+{
+    image_t     image;
+    const char  *ext;
+    byte        *rawdata, *pic, *buffer;
+    ssize_t     rawlen;
+    qerror_t    ret;
+    double      start;
+    size_t      size, k;
+    int         fmt, pass;
+
+    ext = COM_FileExtension(name);
+    for (fmt = 0; fmt < IM_MAX; fmt++) {
+        if (*ext && !Q_stricmp(ext + 1, img_loaders[fmt].ext)) {
+            break;
+        }
+    }
+    if (fmt == IM_MAX) {
+        return Q_ERR_INVALID_PATH;
+    }
+
+    rawlen = FS_LoadFile(name, (void **)&rawdata);
+    if (!rawdata) {
+        return rawlen;
+    }
+
+    memset(&image, 0, sizeof(image));
+    image.type = IT_WALL;
+    pic = NULL;
+    ret = img_loaders[fmt].load(rawdata, rawlen, &image, &pic);
+    FS_FreeFile(rawdata);
+    if (ret) {
+        return ret;
+    }
+
+    int w = image.upload_width;
+    int h = image.upload_height;
+    int rw = max(1, min(w * 3 / 4, MAX_TEXTURE_SIZE));
+    int rh = max(1, h * 3 / 4);
+    size = (size_t)w * h * 4;
+
+    buffer = (byte *)R_Malloc(max(size, (size_t)rw * rh * 4));
+
+    for (pass = 0; pass < 2; pass++) {
+        img_simd = (qboolean)(pass == 1);
+
+        start = IMG_BenchmarkTime();
+        memcpy(buffer, pic, size);
+        for (int mw = w, mh = h; mw > 1 && mh > 1; mw >>= 1, mh >>= 1) {
+            IMG_MipMap(buffer, buffer, mw, mh);
+        }
+        times[pass][0] += IMG_BenchmarkTime() - start;
+
+        start = IMG_BenchmarkTime();
+        IMG_ResampleTexture(pic, w, h, buffer, rw, rh);
+        times[pass][1] += IMG_BenchmarkTime() - start;
+
+        // round trip through linear space, powf against the tables
+        start = IMG_BenchmarkTime();
+        for (k = 0; k < size; k++) {
+            if (pass)
+                buffer[k] = IMG_EncodeSRGB(IMG_DecodeSRGB(pic[k]) * 0.5f);
+            else
+                buffer[k] = IMG_EncodeSRGBExact(IMG_DecodeSRGBExact(pic[k]) * 0.5f);
+        }
+        times[pass][2] += IMG_BenchmarkTime() - start;
+    }
+
+    img_simd = true;
+
+    Z_Free(buffer);
+    Z_Free(pic);
+    return Q_ERR_SUCCESS;
+}
+#endif
+
 #define TRY_IMAGE_SRC_GAME      1
 #define TRY_IMAGE_SRC_BASE      0
 
@@ -883,10 +1538,14 @@ static int _try_image_format(imageformat_t fmt, image_t* image, int try_src, byt
         FS_FreeFile(data_base);
     }
 
-    // decompress the image
-    ret = img_loaders[fmt].load(data, len, image, pic);
-
-    FS_FreeFile(data);
+    // decompress the image, possibly in the background
+    if (IMG_QueueDecode(fmt, image, data, len)) {
+        *pic = NULL;
+        ret = Q_ERR_SUCCESS;
+    } else {
+        ret = img_loaders[fmt].load(data, len, image, pic);
+        FS_FreeFile(data);
+    }
 
     image->filepath[0] = 0;
     if (ret >= 0) {
@@ -1198,6 +1857,8 @@ static qerror_t find_or_load_image(const char *name, size_t len,
         return Q_ERR_OUT_OF_SLOTS;
     }
 
+    img_decodeAllowed = true;
+
     int override_textures = !!r_override_textures->integer;
     if (!vid_rtx->integer && (type != IT_PIC) && !gl_use_hd_assets->integer)
         override_textures = 0;
@@ -1242,6 +1903,8 @@ static qerror_t find_or_load_image(const char *name, size_t len,
         }
     }
 
+    img_decodeAllowed = false;
+
     if (ret < 0) {
         memset(image, 0, sizeof(*image));
         return ret;
@@ -1251,8 +1914,12 @@ static qerror_t find_or_load_image(const char *name, size_t len,
 
     image->is_srgb = !!(flags & IF_SRGB);
 
-    // upload the image
-    IMG_Load(image, pic);
+    // upload the image, or show the placeholder until it's decoded
+    if (img_decodes[image - r_images]) {
+        IMG_SetPlaceholder(image, true);
+    } else {
+        IMG_Load(image, pic);
+    }
 
     *image_p = image;
     return Q_ERR_SUCCESS;
@@ -1329,6 +1996,8 @@ image_t* IMG_Clone(image_t* image, const char* new_name) {
     if (image == R_NOTEXTURE)
         return image;
 
+    IMG_FinishPending(image);
+
     image_t* new_image = alloc_image();
     if (!new_image)
         return R_NOTEXTURE;
@@ -1542,6 +2211,7 @@ void IMG_FreeUnused(void)
         List_Remove(&image->entry);
 
         // free it
+        IMG_CancelPending(image);
         IMG_Unload(image);
 
         memset(image, 0, sizeof(*image));
@@ -1562,6 +2232,7 @@ void IMG_FreeAll(void)
         if (!image->registration_sequence)
             continue;        // free image_t slot
         // free it
+        IMG_CancelPending(image);
         IMG_Unload(image);
 
         memset(image, 0, sizeof(*image));
@@ -1642,6 +2313,9 @@ void IMG_Init(void)
     r_texture_formats = Cvar_Get("r_texture_formats", "pjt", 0);
     r_texture_formats->changed = r_texture_formats_changed;
     r_texture_formats_changed(r_texture_formats);
+    r_texture_threads = Cvar_Get("r_texture_threads", "2", CVAR_REFRESH);
+
+    IMG_InitSRGBTables();
 
     r_screenshot_format = Cvar_Get("gl_screenshot_format", "jpg", CVAR_ARCHIVE);
     r_screenshot_format = Cvar_Get("gl_screenshot_format", "png", CVAR_ARCHIVE);
@@ -1657,10 +2331,14 @@ void IMG_Init(void)
 
     // &r_images[0] == R_NOTEXTURE
     r_numImages = 1;
+
+    IMG_StartDecodeThreads();
 }
 
 void IMG_Shutdown(void)
 {
+    IMG_StopDecodeThreads();
+
     Cmd_Unregister(img_cmd);
     r_numImages = 0;
 }
@@ -175,23 +175,22 @@ qhandle_t R_RegisterModel(const char *name) {
 	if (!ret && ident == IQM_IDENT && !model->skeletalModelData) {
 		model->skeletalModelData = &r_skeletalModels[(model - r_models) + 1];
 
-		// Generate Skeletal Model Data.
-		SKM_GenerateModelData(model);
-
 		// This function needs rewriting but who am I... got 2 hands, so little time, right?
+		const std::string modelPath = normalized;
 		memcpy(extension, ".skc", 4);
+		const std::string configPath = normalized;
+
+		// Stuff back in iqm for sake.
+		memcpy(extension, ".iqm", 4);
 
-		// Now, load up our SKM config file.
-		const bool result = SKM_LoadAndParseConfiguration( model, normalized );
+		// Generate Skeletal Model Data and load up our SKM config file, or load both from the binary cache.
+		const bool result = SKM_LoadOrGenerateModelData( model, modelPath, configPath );
 		if (result) {
-			Com_DPrintf("Loaded up SKM Config file: %s\n", normalized );
+			Com_DPrintf("Loaded up SKM Config file: %s\n", configPath.c_str() );
 
 		} else {
-			Com_DPrintf("Couldn't find/load SKM Config file: %s\n", normalized );
+			Com_DPrintf("Couldn't find/load SKM Config file: %s\n", configPath.c_str() );
 		}
-
-		// Stuff back in iqm for sake.
-		memcpy(extension, ".iqm", 4);
 	}
 
 	FS_FreeFile(rawdata);
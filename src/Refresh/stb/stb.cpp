@@ -21,9 +21,32 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include "../../Common/Common.h"
 #include "../../Common/Zone.h"
 
-#define STBI_MALLOC(sz)           Z_Malloc(sz)
-#define STBI_REALLOC(p,newsz)     Z_Realloc(p,newsz)
-#define STBI_FREE(p)              Z_Free(p)
+// The zone allocator may only be used from the main thread, image decode
+// threads set this to make stb_image allocate from the C heap instead.
+thread_local qboolean stbi_use_system_heap;
+
+static void *stbi_malloc(size_t sz)
+{
+    return stbi_use_system_heap ? malloc(sz) : Z_Malloc(sz);
+}
+
+static void *stbi_realloc(void *p, size_t newsz)
+{
+    return stbi_use_system_heap ? realloc(p, newsz) : Z_Realloc(p, newsz);
+}
+
+static void stbi_free(void *p)
+{
+    if (stbi_use_system_heap) {
+        free(p);
+    } else {
+        Z_Free(p);
+    }
+}
+
+#define STBI_MALLOC(sz)           stbi_malloc(sz)
+#define STBI_REALLOC(p,newsz)     stbi_realloc(p,newsz)
+#define STBI_FREE(p)              stbi_free(p)
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
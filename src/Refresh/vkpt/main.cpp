@@ -1611,6 +1611,8 @@ add_dlights(const rdlight_t* lights, int num_lights, QVKUniformBuffer_t* ubo)
 {
 	ubo->num_sphere_lights = 0;
 
+	num_lights = min(num_lights, MAX_LIGHT_SOURCES);
+
 	for (int i = 0; i < num_lights; i++)
 	{
 		const rdlight_t* light = lights + i;
@@ -3295,6 +3297,7 @@ retry:;
 	}
 
 	vkpt_textures_destroy_unused();
+	IMG_UpdatePending();
 	vkpt_textures_end_registration();
 	vkpt_textures_update_descriptor_set();
 
@@ -3943,6 +3946,7 @@ R_SetSky_RTX(const char* name, float rotate, vec3_t& axis)
 		Q_concat(pathname, sizeof(pathname), "env/", name, suf[i], ".tga", NULL);
 		FS_NormalizePath(pathname, pathname);
 		image_t *img = IMG_Find(pathname, IT_SKY, IF_NONE);
+		IMG_FinishPending(img);
 
 		if(img == R_NOTEXTURE) {
 			if(data) {
@@ -105,7 +105,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #define SHADER_MAX_ENTITIES                  4096
 #define SHADER_MAX_BSP_ENTITIES              128
-#define MAX_LIGHT_SOURCES                    32
+#define MAX_LIGHT_SOURCES                    64
 #define MAX_LIGHT_STYLES                     256
 
 #define TLAS_INDEX_GEOMETRY      0
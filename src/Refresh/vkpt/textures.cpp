@@ -510,24 +510,12 @@ IMG_Load
 
 static inline float decode_srgb(byte pix)
 {
-	float x = (float)pix / 255.f;
-	
-	if (x < 0.04045f)
-		return x / 12.92f;
-
-	return powf((x + 0.055f) / 1.055f, 2.4f);
+	return IMG_DecodeSRGB(pix);
 }
 
 static inline byte encode_srgb(float x)
 {
-    if (x <= 0.0031308f)
-        x *= 12.92f;
-    else
-        x = 1.055f * powf(x, 1.f / 2.4f) - 0.055f;
-     
-    x = max(0.f, min(1.f, x));
-
-    return (byte)roundf(x * 255.f);
+	return IMG_EncodeSRGB(x);
 }
 
 struct filterscratch_s {
@@ -717,6 +705,8 @@ static inline void bilerp_get_next_output_line_from_rgb_f32(struct bilerp_s* bil
 
 // Fake an emissive texture from a diffuse texture by using pixels brighter than a certain amount
 static void apply_fake_emissive_threshold(image_t* image, int bright_threshold_int) {
+	IMG_FinishPending(image);
+
 	int w = image->upload_width;
 	int h = image->upload_height;
 
@@ -883,6 +873,8 @@ image_t* vkpt_fake_emissive_texture(image_t* image, int bright_threshold_int) {
 void
 vkpt_extract_emissive_texture_info(image_t *image)
 {
+	IMG_FinishPending(image);
+
 	int w = image->upload_width;
 	int h = image->upload_height;
 
@@ -982,6 +974,9 @@ void IMG_ReloadAll(void)
     int i, reloaded=0;
     image_t * image;
 
+    // don't let a background decode overwrite the reloaded pixels
+    IMG_FinishAllPending();
+
     for (i = 1, image = r_images + 1; i < r_numImages; i++, image++)
     {
         if (!image->registration_sequence)
@@ -140,6 +140,9 @@ void SV_SpawnServer(MapCommand *cmd)
 		warning_printed = true;
 	}
 
+    // multi-view demos cover a single level
+    SV_MvdStop();
+
     // everyone needs to reconnect
     FOR_EACH_CLIENT(client) {
         SV_ClientReset(client);
@@ -0,0 +1,884 @@
+/***
+*
+*	License here.
+*
+*	@file
+*
+*	Multi-view demo recording: Records the server's point of view into a single demo. Each
+*	server frame's full entity set is encoded once, instead of once per client, along with the
+*	player state, and area bits of every client in game. The resulting file uses the regular
+*	client demo format so it plays back through the existing demo code.
+*
+*	The views of all clients are written as a ServerCommand::PlayerStates block ahead of each
+*	frame, each one delta compressed against the same client's view in the previous frame.
+*	The frame itself carries the view of a followed client (The first client in game, and the
+*	next one when it leaves.) which is shown by default, cl_demopov picks another one during
+*	playback. Prints, and other messages sent to a single client are only archived for the
+*	followed client.
+*
+*	Encoding happens at the end of SV_Frame, the actual writing (And gzip compression, when
+*	recording with -z) is done by a background thread so a slow disk never stalls the server.
+*
+***/
+#include "Server.h"
+
+#include <mutex>
+#include <vector>
+
+
+
+//! Worst case size of a single delta entity state, used to keep a frame from overflowing msg_write.
+static constexpr size_t MVD_ENTITY_MAXSIZE = 128;
+//! Worst case size of a single client's view in the PlayerStates block.
+static constexpr size_t MVD_VIEW_MAXSIZE = 512;
+//! Frames are dropped once the writer thread has this many bytes left to write.
+static constexpr size_t MVD_MAX_QUEUED = 16 * 1024 * 1024;
+//! Furthest back a frame can be delta compressed against. The frame header has 5 bits for
+//! the delta, and 31 means the frame is not delta compressed.
+static constexpr int64_t MVD_MAX_DELTA = (1 << (32 - FRAMENUM_BITS)) - 2;
+
+/**
+*   The view of a single client in a recorded frame.
+**/
+typedef struct {
+    qboolean    inUse;              // False if the client wasn't in game.
+    PlayerState playerState;
+    int32_t     areaBytes;
+    byte        areaBits[MAX_MAP_AREA_BYTES];
+} MVDView;
+
+/**
+*   A recorded frame.
+**/
+typedef struct {
+    int64_t     number;             // Demo frame number.
+    int32_t     numEntities;
+    EntityState *entities;          // [MAX_PACKET_ENTITIES], sorted by entity number.
+    MVDView     *views;             // [sv_maxclients], indexed by client number.
+    PlayerState playerState;        // Player state of the followed client.
+    int32_t     clientNumber;
+    int32_t     areaBytes;
+    byte        areaBits[MAX_MAP_AREA_BYTES];
+} MVDFrame;
+
+static struct {
+    qhandle_t   file;
+    char        name[MAX_OSPATH];
+
+    // Baselines written in the gamestate.
+    EntityState *baselines;
+    int32_t     numBaselines;
+
+    // The last frame written, and the frame being built.
+    MVDFrame    frames[2];
+    int32_t     lastFrame;          // Index of the last frame written, -1 if none yet.
+
+    // Client whose player state is recorded, NULL if there is none.
+    client_t    *pov;
+
+    // Configstrings, prints, sounds and temp entities archived since the last frame.
+    SizeBuffer  message;
+    byte        messageBuffer[MAX_MSGLEN];
+
+    // Number of the frame being recorded. Counts dropped frames too, so the
+    // demo timeline matches the server's.
+    int64_t     frameNumber;
+
+    int64_t     framesWritten;
+    int64_t     framesDropped;
+    int64_t     othersDropped;
+} mvd;
+
+//! Writer thread state.
+static std::thread              mvd_writeThread;
+static std::mutex               mvd_writeMutex;
+static std::condition_variable  mvd_writeWork;
+static std::vector<byte>        mvd_writeQueue;     // Length prefixed messages waiting to be written.
+static qboolean                 mvd_writeQuit;
+static ssize_t                  mvd_writeError;
+
+
+
+/*
+=============================================================================
+
+Background writer
+
+=============================================================================
+*/
+
+/**
+*   @brief  Writes out the queued messages until told to quit, and the queue is empty.
+**/
+static void SV_MvdWriteThread(qhandle_t file)
+{
+    std::vector<byte> buffer;
+    ssize_t ret;
+
+    std::unique_lock<std::mutex> lock(mvd_writeMutex);
+
+    while (1) {
+        mvd_writeWork.wait(lock, [] { return mvd_writeQuit || !mvd_writeQueue.empty(); });
+        if (mvd_writeQueue.empty()) {
+            break;
+        }
+
+        // Take the whole queue, and write it without holding the lock.
+        buffer.swap(mvd_writeQueue);
+
+        lock.unlock();
+        ret = FS_Write(buffer.data(), buffer.size(), file);
+        buffer.clear();
+        lock.lock();
+
+        if (ret < 0) {
+            mvd_writeError = ret;
+            mvd_writeQueue.clear();
+            break;
+        }
+    }
+}
+
+/**
+*   @brief  Appends a length prefixed message to the write queue.
+**/
+static void SV_MvdQueueData(const byte *data, size_t length)
+{
+    uint32_t msglen = LittleLong(length);
+
+    mvd_writeQueue.insert(mvd_writeQueue.end(), (byte *)&msglen, (byte *)&msglen + 4);
+    mvd_writeQueue.insert(mvd_writeQueue.end(), data, data + length);
+}
+
+/**
+*   @brief  Queues 'first' and 'second' for writing, as one message if they fit, as two if they don't.
+*           Returns false if the writer thread is too far behind.
+**/
+static qboolean SV_MvdQueueMessages(const SizeBuffer *first, const SizeBuffer *second)
+{
+    size_t length = first->currentSize + (second ? second->currentSize : 0);
+
+    std::lock_guard<std::mutex> lock(mvd_writeMutex);
+
+    if (mvd_writeQueue.size() + length + 8 > MVD_MAX_QUEUED) {
+        return false;
+    }
+
+    if (!second || !second->currentSize) {
+        SV_MvdQueueData(first->data, first->currentSize);
+    } else if (!first->currentSize) {
+        SV_MvdQueueData(second->data, second->currentSize);
+    } else if (length <= MAX_MSGLEN) {
+        uint32_t msglen = LittleLong(length);
+
+        mvd_writeQueue.insert(mvd_writeQueue.end(), (byte *)&msglen, (byte *)&msglen + 4);
+        mvd_writeQueue.insert(mvd_writeQueue.end(), first->data, first->data + first->currentSize);
+        mvd_writeQueue.insert(mvd_writeQueue.end(), second->data, second->data + second->currentSize);
+    } else {
+        SV_MvdQueueData(first->data, first->currentSize);
+        SV_MvdQueueData(second->data, second->currentSize);
+    }
+
+    mvd_writeWork.notify_one();
+    return true;
+}
+
+/**
+*   @brief  Queues the contents of msg_write as a message, and clears it.
+**/
+static void SV_MvdFlushMessage(void)
+{
+    if (msg_write.currentSize) {
+        SV_MvdQueueMessages(&msg_write, NULL);
+    }
+    SZ_Clear(&msg_write);
+}
+
+
+/*
+=============================================================================
+
+Frame encoding
+
+=============================================================================
+*/
+
+/**
+*   @brief  Returns the client to follow: the current one if it is still in game, otherwise
+*           the first client that is.
+**/
+static client_t *SV_MvdFindPOV(void)
+{
+    client_t *client;
+
+    if (mvd.pov && mvd.pov->connectionState == ConnectionState::Spawned && mvd.pov->edict->client) {
+        return mvd.pov;
+    }
+
+    FOR_EACH_CLIENT(client) {
+        if (client->connectionState == ConnectionState::Spawned && client->edict->client) {
+            return client;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+*   @brief  Gathers every entity that is sent to any client, regardless of visibility, and the
+*           view of every client in game.
+**/
+static void SV_MvdBuildFrame(MVDFrame *frame)
+{
+    client_t *client;
+    Entity *ent;
+    EntityState *state;
+    PlayerState *ps;
+    MVDView *view;
+    vec3_t org;
+    int32_t e;
+
+    frame->number = mvd.frameNumber;
+
+    // The view of each client.
+    for (e = 0; e < sv_maxclients->integer; e++) {
+        frame->views[e].inUse = false;
+    }
+
+    FOR_EACH_CLIENT(client) {
+        if (client->connectionState != ConnectionState::Spawned || !client->edict->client) {
+            continue;
+        }
+
+        ps = &client->edict->client->playerState;
+        org = ps->pmove.origin + ps->pmove.viewOffset;
+
+        view = &frame->views[client->number];
+        view->inUse = true;
+        view->playerState = *ps;
+        view->areaBytes = CM_WriteAreaBits(&sv.cm, view->areaBits, CM_LeafArea(CM_PointLeaf(&sv.cm, org)));
+    }
+
+    // The followed client's view.
+    mvd.pov = SV_MvdFindPOV();
+    if (mvd.pov) {
+        view = &frame->views[mvd.pov->number];
+
+        frame->playerState = view->playerState;
+        frame->clientNumber = mvd.pov->number;
+        frame->areaBytes = view->areaBytes;
+        memcpy(frame->areaBits, view->areaBits, view->areaBytes);
+    } else {
+        // Nobody in game, look at the world from its origin.
+        frame->playerState = nullPlayerState;
+        frame->playerState.pmove.type = EnginePlayerMoveType::Freeze;
+        frame->playerState.fov = 90;
+        frame->clientNumber = 0;
+        frame->areaBytes = 0;
+    }
+
+    // The full entity set.
+    frame->numEntities = 0;
+    for (e = 1; e < ge->numberOfEntities; e++) {
+        ent = EDICT_NUM(e);
+
+        if (!ent->inUse) {
+            continue;
+        }
+        if (ent->serverFlags & EntityServerFlags::NoClient) {
+            continue;
+        }
+        if (!ES_INUSE(&ent->currentState)) {
+            continue;
+        }
+
+        state = &frame->entities[frame->numEntities];
+        *state = ent->currentState;
+        state->number = e;
+        state->solid = sv.entities[e].solid32;
+
+        if (++frame->numEntities == MAX_PACKET_ENTITIES) {
+            break;
+        }
+    }
+}
+
+/**
+*   @brief  Writes a delta update of the frame's entities to msg_write. Returns false, and
+*           clears msg_write, if they don't fit.
+**/
+static qboolean SV_MvdEmitPacketEntities(const MVDFrame *from, const MVDFrame *to)
+{
+    const EntityState *oldent, *newent, *base;
+    int32_t oldindex, newindex, fromNumEntities;
+    int32_t oldnum, newnum;
+
+    fromNumEntities = from ? from->numEntities : 0;
+
+    newindex = 0;
+    oldindex = 0;
+    oldent = newent = NULL;
+    while (newindex < to->numEntities || oldindex < fromNumEntities) {
+        if (msg_write.currentSize + MVD_ENTITY_MAXSIZE > msg_write.maximumSize) {
+            SZ_Clear(&msg_write);
+            return false;
+        }
+
+        if (newindex >= to->numEntities) {
+            newnum = 9999;
+        } else {
+            newent = &to->entities[newindex];
+            newnum = newent->number;
+        }
+
+        if (oldindex >= fromNumEntities) {
+            oldnum = 9999;
+        } else {
+            oldent = &from->entities[oldindex];
+            oldnum = oldent->number;
+        }
+
+        if (newnum == oldnum) {
+            // Delta update from old position, players are always 'new entities'.
+            MSG_WriteDeltaEntityState(oldent, newent, newnum <= sv_maxclients->integer ? MSG_ES_NEWENTITY : 0);
+            oldindex++;
+            newindex++;
+            continue;
+        }
+
+        if (newnum < oldnum) {
+            // This is a new entity, send it from the baseline.
+            base = newnum < mvd.numBaselines ? &mvd.baselines[newnum] : &nullEntityState;
+            MSG_WriteDeltaEntityState(base, newent, MSG_ES_FORCE | MSG_ES_NEWENTITY);
+            newindex++;
+            continue;
+        }
+
+        if (newnum > oldnum) {
+            // The old entity isn't present in the new frame.
+            MSG_WriteDeltaEntityState(oldent, NULL, MSG_ES_FORCE);
+            oldindex++;
+            continue;
+        }
+    }
+
+    MSG_WriteInt16(0);      // end of packetentities
+    return true;
+}
+
+/**
+*   @brief  Writes the views of the clients in game to msg_write, each delta compressed against
+*           the same client's view in 'from' if it is in there. Returns false, and clears
+*           msg_write, if they don't fit.
+**/
+static qboolean SV_MvdEmitViews(const MVDFrame *from, MVDFrame *to)
+{
+    const MVDView *oldview;
+    MVDView *view;
+    byte *flags;
+    int32_t i, count;
+
+    count = 0;
+    for (i = 0; i < sv_maxclients->integer; i++) {
+        if (to->views[i].inUse) {
+            count++;
+        }
+    }
+
+    MSG_WriteUint8(ServerCommand::PlayerStates);
+    MSG_WriteInt32(to->number & FRAMENUM_MASK);
+    MSG_WriteInt16(count);
+
+    for (i = 0; i < sv_maxclients->integer; i++) {
+        view = &to->views[i];
+        if (!view->inUse) {
+            continue;
+        }
+
+        if (msg_write.currentSize + MVD_VIEW_MAXSIZE > msg_write.maximumSize) {
+            SZ_Clear(&msg_write);
+            return false;
+        }
+
+        oldview = from && from->views[i].inUse ? &from->views[i] : NULL;
+
+        MSG_WriteUint8(i);
+
+        // byte to be patched
+        flags = (byte *)SZ_GetSpace(&msg_write, 1);
+
+        MSG_WriteUint8(view->areaBytes);
+        MSG_WriteData(view->areaBits, view->areaBytes);
+
+        *flags = (byte)MSG_WriteDeltaPlayerstate(oldview ? &oldview->playerState : NULL, &view->playerState, 0);
+        if (!oldview) {
+            *flags |= EPS_NODELTA;
+        }
+    }
+
+    return true;
+}
+
+/**
+*   @brief  Writes the frame to msg_write, delta compressed against 'from' if there is one.
+*           Returns false, and clears msg_write, if it doesn't fit.
+**/
+static qboolean SV_MvdWriteFrame(const MVDFrame *from, MVDFrame *to)
+{
+    byte *b1, *b2;
+    uint32_t extraflags;
+    int32_t delta, clientNumber;
+
+    // the views of all clients go first, so playback can pick one of them for this frame
+    if (!SV_MvdEmitViews(from, to)) {
+        return false;
+    }
+
+    delta = from ? to->number - from->number : 31;
+
+    // first byte to be patched
+    b1 = (byte *)SZ_GetSpace(&msg_write, 1);
+
+    MSG_WriteInt32((to->number & FRAMENUM_MASK) | (delta << FRAMENUM_BITS));
+
+    // second byte to be patched
+    b2 = (byte *)SZ_GetSpace(&msg_write, 1);
+
+    // send over the areaBits
+    MSG_WriteUint8(to->areaBytes);
+    MSG_WriteData(to->areaBits, to->areaBytes);
+
+    // delta encode the playerstate, demos need all of it
+    extraflags = MSG_WriteDeltaPlayerstate(from ? &from->playerState : NULL, &to->playerState, 0);
+
+    clientNumber = from ? from->clientNumber : 0;
+    if (clientNumber != to->clientNumber) {
+        extraflags |= EPS_CLIENTNUM;
+        MSG_WriteUint8(to->clientNumber);
+    }
+
+    // save 3 high bits of extraflags
+    *b1 = ServerCommand::Frame | ((extraflags & 0x70) << 1);
+
+    // save 4 low bits of extraflags
+    *b2 = (extraflags & 0x0F) << SUPPRESSCOUNT_BITS;
+
+    // delta encode the entities
+    return SV_MvdEmitPacketEntities(from, to);
+}
+
+/**
+*   @brief  Records the frame that was just run. Called by SV_Frame after the client messages are sent.
+**/
+void SV_MvdEndFrame(void)
+{
+    MVDFrame *from, *to;
+    ssize_t error;
+
+    if (!mvd.file) {
+        return;
+    }
+
+    // stop if the writer thread failed
+    {
+        std::lock_guard<std::mutex> lock(mvd_writeMutex);
+        error = mvd_writeError;
+    }
+    if (error) {
+        Com_EPrintf("Couldn't write MVD: %s\n", Q_ErrorString(error));
+        SV_MvdStop();
+        return;
+    }
+
+    mvd.frameNumber++;
+
+    from = mvd.lastFrame >= 0 ? &mvd.frames[mvd.lastFrame] : NULL;
+    to = &mvd.frames[mvd.lastFrame >= 0 ? mvd.lastFrame ^ 1 : 0];
+
+    SV_MvdBuildFrame(to);
+
+    // send a full frame if too many frames were dropped since the last one written
+    if (from && to->number - from->number > MVD_MAX_DELTA) {
+        from = NULL;
+    }
+
+    // drop the frame if it doesn't fit, or the writer can't keep up, the
+    // next one is delta compressed against the last one written instead
+    if (!SV_MvdWriteFrame(from, to) || !SV_MvdQueueMessages(&mvd.message, &msg_write)) {
+        SZ_Clear(&msg_write);
+        if (++mvd.framesDropped == 50 && mvd.framesWritten < 10) {
+            Com_WPrintf("Too many MVD frames are dropped.\n");
+        }
+        return;
+    }
+
+    SZ_Clear(&msg_write);
+    SZ_Clear(&mvd.message);
+
+    mvd.lastFrame = to - mvd.frames;
+    mvd.framesWritten++;
+}
+
+
+/*
+=============================================================================
+
+Archiving of non-frame data
+
+=============================================================================
+*/
+
+/**
+*   @brief  Archives the data in msg_write from 'start' on.
+**/
+static void SV_MvdArchive(size_t start)
+{
+    size_t length = msg_write.currentSize - start;
+
+    if (!length) {
+        return;
+    }
+
+    if (mvd.message.currentSize + length > mvd.message.maximumSize) {
+        mvd.othersDropped++;
+        return;
+    }
+
+    SZ_Write(&mvd.message, msg_write.data + start, length);
+}
+
+/**
+*   @brief  Archives the contents of msg_write, which is about to be sent to everyone.
+*           (Or to everyone in the PVS/PHS, the demo gets it all.)
+**/
+void SV_MvdMulticast(void)
+{
+    if (!mvd.file) {
+        return;
+    }
+
+    SV_MvdArchive(0);
+}
+
+/**
+*   @brief  Archives the contents of msg_write, which is about to be sent to 'client', if it
+*           is the client that is followed.
+**/
+void SV_MvdUnicast(client_t *client)
+{
+    if (!mvd.file || client != mvd.pov || !msg_write.currentSize) {
+        return;
+    }
+
+    // commands are meant for the client, not for playback
+    if (msg_write.data[0] == ServerCommand::StuffText || msg_write.data[0] == ServerCommand::Disconnect) {
+        return;
+    }
+
+    SV_MvdArchive(0);
+}
+
+/**
+*   @brief  Archives a sound. These are sent to each client separately, so they are written
+*           here once, positioned, for everyone.
+**/
+void SV_MvdStartSound(Entity *edict, int32_t channel, int32_t soundIndex, float volume, float attenuation, float timeOffset)
+{
+    size_t start;
+    int32_t flags;
+    vec3_t origin;
+
+    if (!mvd.file) {
+        return;
+    }
+
+    flags = SoundCommandBits::Entity | SoundCommandBits::Position;
+    if (volume != DEFAULT_SOUND_PACKET_VOLUME)
+        flags |= SoundCommandBits::Volume;
+    if (attenuation != DEFAULT_SOUND_PACKET_ATTENUATION)
+        flags |= SoundCommandBits::Attenuation;
+    if (timeOffset)
+        flags |= SoundCommandBits::Offset;
+
+    // use the entity origin unless it is a bmodel
+    if (edict->solid == Solid::BSP) {
+        origin = edict->currentState.origin + vec3_scale(edict->mins + edict->maxs, 0.5f);
+    } else {
+        origin = edict->currentState.origin;
+    }
+
+    // write it after whatever msg_write may hold, and leave that untouched
+    start = msg_write.currentSize;
+
+    MSG_WriteUint8(ServerCommand::Sound);
+    MSG_WriteUint8(flags);
+    MSG_WriteUint8(soundIndex);
+
+    if (flags & SoundCommandBits::Volume)
+        MSG_WriteUint8(volume * 255);
+    if (flags & SoundCommandBits::Attenuation)
+        MSG_WriteUint8(attenuation * 64);
+    if (flags & SoundCommandBits::Offset)
+        MSG_WriteUint8(timeOffset * 1000);
+
+    MSG_WriteUint16((NUM_FOR_EDICT(edict) << 3) | (channel & 7));
+    MSG_WriteVector3(origin);
+
+    SV_MvdArchive(start);
+
+    msg_write.currentSize = start;
+}
+
+
+/*
+=============================================================================
+
+Recording
+
+=============================================================================
+*/
+
+/**
+*   @brief  Writes the serverdata, configstrings and baselines, the same as SV_New_f sends them.
+**/
+static void SV_MvdWriteGamestate(void)
+{
+    Entity *ent;
+    EntityState *base;
+    char *string;
+    size_t length;
+    int32_t i;
+
+    // the entity baselines
+    mvd.numBaselines = ge->numberOfEntities;
+    mvd.baselines = (EntityState *)Z_TagMallocz(sizeof(*mvd.baselines) * mvd.numBaselines, TAG_MVD);
+
+    for (i = 1; i < mvd.numBaselines; i++) {
+        ent = EDICT_NUM(i);
+        if (!ent->inUse || !ES_INUSE(&ent->currentState)) {
+            continue;
+        }
+        mvd.baselines[i] = ent->currentState;
+        mvd.baselines[i].number = i;
+    }
+
+    // send the serverdata
+    mvd.pov = SV_MvdFindPOV();
+
+    MSG_WriteUint8(ServerCommand::ServerData);
+    MSG_WriteInt32(PROTOCOL_VERSION_POLYHEDRON_CURRENT);
+    MSG_WriteInt32(sv.spawncount);
+    MSG_WriteUint8(1);      // demos are always attract loops
+    MSG_WriteString(fs_game->string);
+    MSG_WriteInt16(mvd.pov ? mvd.pov->number : 0);
+    MSG_WriteString(sv.configstrings[ConfigStrings::Name]);
+    MSG_WriteInt16(0);      // minor protocol version
+    MSG_WriteUint8(sv.serverState);
+
+    // configstrings
+    for (i = 0; i < ConfigStrings::MaxConfigStrings; i++) {
+        string = sv.configstrings[i];
+        if (!string[0]) {
+            continue;
+        }
+
+        length = strlen(string);
+        if (length > MAX_QPATH) {
+            length = MAX_QPATH;
+        }
+
+        if (msg_write.currentSize + length + 64 > msg_write.maximumSize) {
+            SV_MvdFlushMessage();
+        }
+
+        MSG_WriteUint8(ServerCommand::ConfigString);
+        MSG_WriteInt16(i);
+        MSG_WriteData(string, length);
+        MSG_WriteUint8(0);
+    }
+
+    // entityBaselines
+    for (i = 1, base = mvd.baselines + 1; i < mvd.numBaselines; i++, base++) {
+        if (!base->number) {
+            continue;
+        }
+
+        if (msg_write.currentSize + MVD_ENTITY_MAXSIZE > msg_write.maximumSize) {
+            SV_MvdFlushMessage();
+        }
+
+        MSG_WriteUint8(ServerCommand::SpawnBaseline);
+        MSG_WriteDeltaEntityState(NULL, base, MSG_ES_FORCE);
+    }
+
+    MSG_WriteUint8(ServerCommand::StuffText);
+    MSG_WriteString("precache\n");
+
+    SV_MvdFlushMessage();
+}
+
+static const cmd_option_t o_mvdrecord[] = {
+    { "h", "help", "display this message" },
+    { "z", "compress", "compress demo with gzip" },
+    { NULL }
+};
+
+/*
+==================
+SV_MvdRecord_f
+
+mvdrecord [-z] <demoname>
+
+Begins recording a multi-view demo of the current level.
+==================
+*/
+static void SV_MvdRecord_f(void)
+{
+    char buffer[MAX_OSPATH];
+    unsigned mode = FS_MODE_WRITE;
+    qhandle_t f;
+    int c;
+
+    while ((c = Cmd_ParseOptions(o_mvdrecord)) != -1) {
+        switch (c) {
+        case 'h':
+            Cmd_PrintUsage(o_mvdrecord, "<filename>");
+            Com_Printf("Begin multi-view demo recording. Records every entity, and the view\n"
+                       "of every client in game. Playback follows the first client in game,\n"
+                       "use cl_demopov or demopov to watch another one.\n");
+            Cmd_PrintHelp(o_mvdrecord);
+            return;
+        case 'z':
+            mode |= FS_FLAG_GZIP;
+            break;
+        default:
+            return;
+        }
+    }
+
+    if (mvd.file) {
+        Com_Printf("Already recording to %s.\n", mvd.name);
+        return;
+    }
+
+    if (!cmd_optarg[0]) {
+        Com_Printf("Missing filename argument.\n");
+        Cmd_PrintHint();
+        return;
+    }
+
+    if (!svs.initialized || sv.serverState != ServerState::Game) {
+        Com_Printf("No level is running.\n");
+        return;
+    }
+
+    f = FS_EasyOpenFile(buffer, sizeof(buffer), mode, "demos/", cmd_optarg, ".dm2");
+    if (!f) {
+        return;
+    }
+
+    mvd.file = f;
+    Q_strlcpy(mvd.name, buffer, sizeof(mvd.name));
+
+    mvd.frames[0].entities = (EntityState *)Z_TagMalloc(sizeof(EntityState) * MAX_PACKET_ENTITIES, TAG_MVD);
+    mvd.frames[1].entities = (EntityState *)Z_TagMalloc(sizeof(EntityState) * MAX_PACKET_ENTITIES, TAG_MVD);
+    mvd.frames[0].views = (MVDView *)Z_TagMallocz(sizeof(MVDView) * sv_maxclients->integer, TAG_MVD);
+    mvd.frames[1].views = (MVDView *)Z_TagMallocz(sizeof(MVDView) * sv_maxclients->integer, TAG_MVD);
+    mvd.lastFrame = -1;
+
+    mvd.frameNumber = 0;
+    mvd.framesWritten = 0;
+    mvd.framesDropped = 0;
+    mvd.othersDropped = 0;
+
+    SZ_Init(&mvd.message, mvd.messageBuffer, sizeof(mvd.messageBuffer));
+
+    // start writing
+    mvd_writeQuit = false;
+    mvd_writeError = 0;
+    mvd_writeThread = std::thread(SV_MvdWriteThread, f);
+
+    SV_MvdWriteGamestate();
+
+    Com_Printf("Recording multi-view demo to %s.\n", buffer);
+}
+
+/**
+*   @brief  Stops recording: waits for the writer thread to write everything out, and closes the demo.
+**/
+void SV_MvdStop(void)
+{
+    char buffer[MAX_QPATH];
+    uint32_t msglen;
+
+    if (!mvd.file) {
+        return;
+    }
+
+    // let the writer finish
+    {
+        std::lock_guard<std::mutex> lock(mvd_writeMutex);
+        mvd_writeQuit = true;
+    }
+    mvd_writeWork.notify_one();
+    mvd_writeThread.join();
+
+    mvd_writeQueue.clear();
+    mvd_writeQueue.shrink_to_fit();
+
+    // finish up
+    msglen = (uint32_t)-1;
+    FS_Write(&msglen, 4, mvd.file);
+
+    Com_FormatSizeLong(buffer, sizeof(buffer), FS_Tell(mvd.file));
+
+    FS_FCloseFile(mvd.file);
+    mvd.file = 0;
+
+    Z_Free(mvd.baselines);
+    Z_Free(mvd.frames[0].entities);
+    Z_Free(mvd.frames[1].entities);
+    Z_Free(mvd.frames[0].views);
+    Z_Free(mvd.frames[1].views);
+    mvd.baselines = NULL;
+    mvd.numBaselines = 0;
+    mvd.frames[0].entities = mvd.frames[1].entities = NULL;
+    mvd.frames[0].views = mvd.frames[1].views = NULL;
+    mvd.pov = NULL;
+
+    SZ_Clear(&mvd.message);
+
+    Com_Printf("Stopped multi-view demo (%s, %lld frames", buffer, (long long)mvd.framesWritten);
+    if (mvd.framesDropped) {
+        Com_Printf(", %lld dropped", (long long)mvd.framesDropped);
+    }
+    if (mvd.othersDropped) {
+        Com_Printf(", %lld messages dropped", (long long)mvd.othersDropped);
+    }
+    Com_Printf(").\n");
+}
+
+static void SV_MvdStop_f(void)
+{
+    if (!mvd.file) {
+        Com_Printf("Not recording a multi-view demo.\n");
+        return;
+    }
+
+    SV_MvdStop();
+}
+
+static const cmdreg_t c_mvd[] = {
+    { "mvdrecord", SV_MvdRecord_f },
+    { "mvdstop", SV_MvdStop_f },
+
+    { NULL }
+};
+
+/**
+*   @brief  Registers the multi-view demo commands.
+**/
+void SV_MvdRegister(void)
+{
+    Cmd_Register(c_mvd);
+}
@@ -1810,6 +1810,9 @@ unsigned SV_Frame(unsigned msec)
         // send messages back to the UDP clients
         SV_SendClientMessages();
 
+        // record the frame to the multi-view demo
+        SV_MvdEndFrame();
+
         // send a heartbeat to the master if needed
         SV_MasterHeartbeat();
 
@@ -1994,6 +1997,8 @@ void SV_Init(void)
 {
     SV_InitOperatorCommands();
 
+    SV_MvdRegister();
+
     SV_RegisterSavegames();
 
     Cvar_Get("protocol", STRINGIFY(PROTOCOL_VERSION_DEFAULT), CVAR_SERVERINFO | CVAR_ROM);
@@ -2168,6 +2173,7 @@ void SV_Shutdown(const char *finalmsg, int32_t errorType)
         return;
 
     SV_FinalMessage(finalmsg, errorType);
+    SV_MvdStop();
     SV_MasterShutdown();
     SV_ShutdownGameProgs();
 
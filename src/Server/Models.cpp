@@ -402,23 +402,23 @@ done:
 	// Assign the skeletal model data struct as a pointer to this model_t
 	model->skeletalModelData = &sv_skeletalModels[index - 1];
 
-	// Generate Skeletal Model Data.
-	SKM_GenerateModelData(model);
-
+	{
 		// This function needs rewriting but who am I... got 2 hands, so little time, right?
-	memcpy(extension, ".skc", 4);
-
-	// Now, load up our SKM config file.
-	if (SKM_LoadAndParseConfiguration( model, normalized )) {
-		Com_DPrintf("Loaded up SKM Config file: %s\n", normalized );
-
-	} else {
-		Com_DPrintf("Couldn't find/load SKM Config file: %s\n", normalized );
+		const std::string modelPath = normalized;
+		memcpy(extension, ".skc", 4);
+		const std::string configPath = normalized;
+		
+		// Stuff back in iqm for sake.
+		memcpy(extension, ".iqm", 4);
+
+		// Generate Skeletal Model Data and load up our SKM config file, or load both from the binary cache.
+		if (SKM_LoadOrGenerateModelData( model, modelPath, configPath )) {
+			Com_DPrintf("Loaded up SKM Config file: %s\n", configPath.c_str() );
+		} else {
+			Com_DPrintf("Couldn't find/load SKM Config file: %s\n", configPath.c_str() );
+		}
 	}
 
-	// Stuff back in iqm for sake.
-	memcpy(extension, ".iqm", 4);
-
 	return index;
 fail2:
 	FS_FreeFile(rawdata);
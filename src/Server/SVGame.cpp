@@ -120,6 +120,8 @@ static void PF_Unicast(Entity *ent, qboolean reliable)
 
     SV_ClientAddMessage(client, flags);
 
+    SV_MvdUnicast(client);
+
     // fix anti-kicking exploit for broken mods
     if (cmd == ServerCommand::Disconnect) {
         client->drop_hack = true;
@@ -175,6 +177,8 @@ static void PF_bprintf(int level, const char *fmt, ...)
         }
     }
 
+    SV_MvdMulticast();
+
     SZ_Clear(&msg_write);
 }
 
@@ -248,6 +252,7 @@ static void PF_cprintf(Entity *ent, int level, const char *fmt, ...)
         SV_ClientAddMessage(client, MSG_RELIABLE);
     }
 
+    SV_MvdUnicast(client);
 
     SZ_Clear(&msg_write);
 }
@@ -452,6 +457,8 @@ static void PF_configstring(int index, const char *val)
         SV_ClientAddMessage(client, MSG_RELIABLE);
     }
 
+    SV_MvdMulticast();
+
     SZ_Clear(&msg_write);
 }
 
@@ -583,6 +590,8 @@ static void PF_StartSound(Entity *edict, int channel,
         channel |= SoundChannel::IgnorePHS;
     }
 
+    SV_MvdStartSound(edict, channel, soundindex, volume, attenuation, timeofs);
+
     FOR_EACH_CLIENT(client) {
         // do not send sounds to connecting clients
         if (client->connectionState != ConnectionState::Spawned || client->download.bytes || client->nodata) {
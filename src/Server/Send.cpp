@@ -167,6 +167,8 @@ void SV_BroadcastPrintf(int level, const char *fmt, ...)
         SV_ClientAddMessage(client, MSG_RELIABLE);
     }
 
+    SV_MvdMulticast();
+
     SZ_Clear(&msg_write);
 }
 
@@ -326,6 +328,9 @@ void SV_Multicast(const vec3_t &origin, int32_t to) {
         SV_ClientAddMessage(client, flags);
     }
 
+    // Multi-view demos get it all.
+    SV_MvdMulticast();
+
     // Clear the msg_write buffer.
     SZ_Clear(&msg_write);
 }
@@ -669,6 +669,16 @@ void SV_InitGameProgs(void);
 void SV_ShutdownGameProgs(void);
 void SV_InitEntity(Entity *e);
 
+//
+// sv_mvd.c
+//
+void SV_MvdRegister(void);
+void SV_MvdStop(void);
+void SV_MvdEndFrame(void);
+void SV_MvdMulticast(void);
+void SV_MvdUnicast(client_t *client);
+void SV_MvdStartSound(Entity *edict, int32_t channel, int32_t soundIndex, float volume, float attenuation, float timeOffset);
+
 //void PF_PMove(PlayerMove *pm);
 
 //
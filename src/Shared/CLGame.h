@@ -292,6 +292,9 @@ extern "C" {
         mmodel_t    *(*BSP_InlineModel) (const char *name);
 		// We need a way to share these values to cgame dll.
         mmodel_t    *(*CM_InlineModel) (cm_t *cm, const char *name);
+        // Returns true if the box touches a leaf that is potentially visible from viewOrigin,
+        // in an area that the current frame has connected to ours.
+        qboolean    (*CM_BoxInPVS) (const vec3_t &viewOrigin, const vec3_t &mins, const vec3_t &maxs);
         // TODO: Document.
         int         (*CM_PointContents) (const vec3_t &p, mnode_t *headNode);
         int         (*CM_TransformedPointContents) (const vec3_t &p, mnode_t *headNode,
@@ -413,6 +416,11 @@ extern "C" {
 		**/
 		void		(*ES_LerpSkeletonPoses) ( EntitySkeleton *entitySkeleton, EntitySkeletonBonePose *outBonePose, int32_t currentFrame, int32_t oldFrame, float backLerp, const int32_t rootBoneAxisFlags );
 		/**
+		*	@brief	Same as ES_LerpSkeletonPoses, but only lerps the bones in boneIndices. All other bones
+		*			are copied from the current frame as is. Used for animation LOD.
+		**/
+		void		(*ES_LerpSkeletonPosesForBones) ( EntitySkeleton *entitySkeleton, EntitySkeletonBonePose *outBonePose, const int32_t *boneIndices, const uint32_t numBoneIndices, int32_t currentFrame, int32_t oldFrame, float backLerp, const int32_t rootBoneAxisFlags );
+		/**
 		*	@brief	Combine 2 poses into one by performing a recursive blend starting from the given boneNode, using the given fraction as "intensity".
 		*	@param	fraction		When set to 1.0, it blends in the animation at 100% intensity. Take 0.5 for example, 
 		*							and a tpose(frac 0.5)+walk would have its arms half bend.
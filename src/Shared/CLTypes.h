@@ -55,7 +55,7 @@ struct explosion_t {
 };
 
 // Maximum amount of explosions.
-static constexpr uint32_t MAX_EXPLOSIONS = 32;
+static constexpr uint32_t MAX_EXPLOSIONS = 128;
 
 // No Particle Settings.
 static constexpr uint32_t NOPART_GRENADE_EXPLOSION = 1;
@@ -145,8 +145,6 @@ struct cl_sustain_t {
 // Client Particle Structure.
 //
 struct cparticle_t {
-    cparticle_t    *next;
-
     float   time;
 
     vec3_t  org;
@@ -22,9 +22,10 @@ static constexpr int32_t MAX_ENT_CLUSTERS = 16;
 
 
 /**
-*   @brief  An std::map storing an entity's key/value dictionary.
+*   @brief  An std::map storing an entity's key/value dictionary. Its comparator is transparent
+*           so it can be searched with string views and literals without allocating.
 **/
-using SpawnKeyValues = std::map<std::string, std::string>;
+using SpawnKeyValues = std::map<std::string, std::string, std::less<>>;
 
 
 /**
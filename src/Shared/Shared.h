@@ -73,6 +73,10 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include <span>
 #include <ranges>
 #include <chrono>
+#include <memory>
+#include <algorithm>
+#include <condition_variable>
+#include <thread>
 
 
 /**